@@ -0,0 +1,86 @@
+#include "Recompiler.hpp"
+
+#include "Core/Debug.hpp"
+
+#include "Emulator/ROM.hpp"
+#include "Emulator/Spec.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <print>
+#include <string>
+#include <string_view>
+
+#if !defined(C8_AOT_CXX)
+#define C8_AOT_CXX "c++"
+#endif
+
+#if !defined(C8_AOT_INCLUDE_DIR)
+#define C8_AOT_INCLUDE_DIR "."
+#endif
+
+int main(int argc, char** argv)
+{
+    using namespace c8emu;
+
+    std::filesystem::path romPath{};
+    std::filesystem::path outPath{};
+    std::string compiler = std::getenv("CXX") ? std::getenv("CXX") : C8_AOT_CXX;
+    bool emitOnly{};
+
+    for (i32 i = 1; i < argc; i++)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--emit-only")
+            emitOnly = true;
+        else if (arg == "--cxx" && i + 1 < argc)
+            compiler = argv[++i];
+        else if (romPath.empty())
+            romPath = arg;
+        else
+            outPath = arg;
+    }
+
+    if (romPath.empty() || outPath.empty())
+    {
+        std::println(std::cerr, "usage: {} [--emit-only] [--cxx <compiler>] <rom_file> <output>", argv[0]);
+        return 1;
+    }
+
+    ROM rom{};
+    if (!rom.Load(romPath) || rom.GetSize() < 2)
+        Panic(ErrorCode::FAILED_TO_READ_ROM, "Couldn't read ROM: {}", romPath.string());
+
+    Recompiler recompiler(rom);
+    recompiler.Discover(C8_ADDR_PC);
+
+    // Without --emit-only the source is kept next to the module for reference
+    std::filesystem::path sourcePath = outPath;
+    if (!emitOnly)
+        sourcePath.replace_extension(".cpp");
+
+    std::ofstream source(sourcePath, std::ios::out | std::ios::trunc);
+    if (!source.is_open())
+        Panic(ErrorCode::FAILED_TO_OPEN_FILE, "Couldn't open file: {}", sourcePath.string());
+
+    source << recompiler.Emit(romPath.filename().string());
+    source.close();
+
+    std::println("Recompiled {} blocks from {}", recompiler.GetNumBlocks(), romPath.filename().string());
+    if (emitOnly)
+        return 0;
+
+    const std::string command = std::format(
+        "\"{}\" -std=c++23 -O2 -DNDEBUG -fno-exceptions -fPIC -shared -fvisibility=hidden -I\"{}\" \"{}\" -o \"{}\"",
+        compiler, C8_AOT_INCLUDE_DIR, sourcePath.string(), outPath.string()
+    );
+
+    if (std::system(command.c_str()) != 0)
+        Panic(ErrorCode::FAILED_TO_COMPILE_MODULE, "Failed to compile module: {}", command);
+
+    std::println("Module written to {}", outPath.string());
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "Recompiler.hpp"
+
+#include "Emulator/AOT.hpp"
+#include "Emulator/Executors.hpp"
+
+#include <format>
+#include <vector>
+
+namespace c8emu {
+
+#define C8_EXECUTOR_NAME(instr, proc) #proc,
+static constexpr std::string_view s_ExecutorNames[] = {
+    C8_FOR_EACH_INSTR(C8_EXECUTOR_NAME)
+};
+#undef C8_EXECUTOR_NAME
+
+static_assert(std::size(s_ExecutorNames) == static_cast<size_t>(Instr::COUNT));
+
+Recompiler::Recompiler(const ROM& rom) noexcept :
+    m_Limit(C8_ADDR_ROM + rom.GetSize())
+{
+    m_RAM.LoadROM(rom);
+}
+
+void Recompiler::Discover(Address entry) noexcept
+{
+    std::vector<Address> pending = { entry };
+    while (!pending.empty())
+    {
+        const Address pc = pending.back();
+        pending.pop_back();
+
+        if (!IsInImage(pc) || m_Blocks.contains(pc))
+            continue;
+
+        Block& block = m_Blocks[pc];
+        DecodeBlock(m_RAM, pc, block, m_Limit);
+
+        const OpCode& last = block.Ops[block.Length - 1].op;
+        const Address next = static_cast<Address>(pc + 2 * block.Length);
+        switch (last.instr)
+        {
+            case Instr::JP_ADDR:
+                pending.push_back(last.nnn);
+                break;
+            case Instr::CALL_ADDR:
+                pending.push_back(last.nnn);
+                pending.push_back(next);
+                break;
+            case Instr::SE_VX_BYTE:
+            case Instr::SE_VX_VY:
+            case Instr::SNE_VX_BYTE:
+            case Instr::SNE_VX_VY:
+            case Instr::SKP_VX:
+            case Instr::SKNP_VX:
+                pending.push_back(next);
+                pending.push_back(next + 2);
+                break;
+            case Instr::LD_VX_KEY:
+                // Keeps re-executing itself until a key is released
+                pending.push_back(next - 2);
+                pending.push_back(next);
+                break;
+            case Instr::RET:
+            case Instr::JP_V0_ADDR:
+                // Targets are only known at runtime, the interpreter picks
+                // these up
+                break;
+            default:
+                pending.push_back(next);
+                break;
+        }
+    }
+}
+
+std::string Recompiler::Emit(std::string_view name) const noexcept
+{
+    std::string out{};
+    std::format_to(std::back_inserter(out), "// Generated by c8emu-aot from {}, do not edit\n\n", name);
+    out += "#include \"Emulator/AOT.hpp\"\n";
+    out += "#include \"Emulator/Executors.hpp\"\n\n";
+    out += "using namespace c8emu;\n\n";
+    out += "namespace {\n\n";
+    out += "const ExecProc* s_Host{};\n\n";
+
+    out += "constexpr Byte IMAGE[] = {";
+    for (size_t addr = C8_ADDR_ROM; addr < m_Limit; addr++)
+    {
+        if ((addr - C8_ADDR_ROM) % 16 == 0)
+            out += "\n   ";
+
+        std::format_to(std::back_inserter(out), " 0x{:02X},", m_RAM[static_cast<Address>(addr)]);
+    }
+    out += "\n};\n\n";
+
+    // Same contract as ExecuteBlock: run at most `count` instructions and
+    // only publish the program counter before the last one
+    for (const auto& [entry, block] : m_Blocks)
+    {
+        std::format_to(std::back_inserter(out), "u32 Block_{:04X}(CPUData* cpu, RAM* ram, UNUSED u32 count) noexcept\n{{\n", entry);
+        for (u32 i{}; i < block.Length; i++)
+        {
+            const OpCode& op = block.Ops[i].op;
+            const bool last = i + 1 == block.Length;
+            if (last)
+                std::format_to(std::back_inserter(out), "    cpu->PC = 0x{:04X};\n", entry + 2 * block.Length);
+
+            // Flags are evaluated lazily, like in the interpreter
+            if (op.vf)
+                out += "    MaterializeFlag(*cpu);\n";
+
+            const std::string_view lazy = !op.vf && ProducesFlag(op.instr) ? "Lazy" : "";
+            if (RunsOnHost(op.instr))
+                std::format_to(std::back_inserter(out), "    {{ static constexpr OpCode op(0x{:04X}); s_Host[{}](*cpu, *ram, op); }}\n", op.raw, static_cast<u32>(op.instr));
+            else
+                std::format_to(std::back_inserter(out), "    {{ static constexpr OpCode op(0x{:04X}); {}{}(*cpu, *ram, op); }}\n", op.raw, lazy, s_ExecutorNames[static_cast<size_t>(op.instr)]);
+
+            if (!last)
+                std::format_to(std::back_inserter(out), "    if (count == {0}) {{ cpu->PC = 0x{1:04X}; return {0}; }}\n", i + 1, entry + 2 * (i + 1));
+        }
+        std::format_to(std::back_inserter(out), "    return {};\n}}\n\n", block.Length);
+    }
+
+    out += "constexpr AotBlock BLOCKS[] = {\n";
+    for (const auto& [entry, block] : m_Blocks)
+        std::format_to(std::back_inserter(out), "    {{ Block_{0:04X}, 0x{0:04X}, {1} }},\n", entry, block.Length);
+    out += "};\n\n";
+
+    out += "void Bind(const ExecProc* executors) noexcept { s_Host = executors; }\n\n";
+    out += "}\n\n";
+
+    out += "extern \"C\" C8_AOT_EXPORT const AotManifest c8aot_manifest = {\n";
+    out += "    C8_AOT_ABI_VERSION,\n";
+    out += "    sizeof(CPUData),\n";
+    out += "    sizeof(RAM),\n";
+    out += "    IMAGE,\n";
+    out += "    sizeof(IMAGE),\n";
+    out += "    BLOCKS,\n";
+    out += "    static_cast<u32>(std::size(BLOCKS)),\n";
+    out += "    Bind,\n";
+    out += "};\n";
+
+    return out;
+}
+
+}
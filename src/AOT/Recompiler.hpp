@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Emulator/BlockCache.hpp"
+#include "Emulator/RAM.hpp"
+#include "Emulator/ROM.hpp"
+
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace c8emu {
+
+// Statically walks every block reachable from the entry point of a ROM and
+// turns them into C++ source that c8emu can load as a recompiled module
+class Recompiler final
+{
+public:
+    explicit Recompiler(const ROM& rom) noexcept;
+
+    void Discover(Address entry) noexcept;
+
+    [[nodiscard]] std::string Emit(std::string_view name) const noexcept;
+    [[nodiscard]] inline size_t GetNumBlocks() const noexcept { return m_Blocks.size(); }
+
+private:
+    [[nodiscard]] constexpr bool IsInImage(Address addr) const noexcept
+    {
+        return addr >= C8_ADDR_ROM && static_cast<size_t>(addr) + 1 < m_Limit;
+    }
+
+private:
+    RAM                      m_RAM{};
+    size_t                   m_Limit{};
+    std::map<Address, Block> m_Blocks{};
+};
+
+}
@@ -1,21 +1,27 @@
 #include "Client.hpp"
 #include "Config.hpp"
+#include "Keyboard.hpp"
+#include "Options.hpp"
 
+#include "Core/Allocations.hpp"
 #include "Core/Debug.hpp"
 
 #include "Emulator/Chip8.hpp"
 #include "Emulator/Spec.hpp"
 
+#include "Renderer/MachineView.hpp"
 #include "Renderer/Renderer.hpp"
+#include "Renderer/SFMLBackend.hpp"
 
+#include <SFML/System/Sleep.hpp>
 #include <SFML/Window/VideoMode.hpp>
 
 namespace c8emu {
 
-Client::Client(i32 argc, char** argv) noexcept
+Client::Client(const Options& options) noexcept
 {
-    if (argc < 2)
-        C8_LOG_WARNING("usage: {} <rom_file>", argv[0]);
+    if (options.ROMPath.empty())
+        C8_LOG_WARNING("usage: {} [--engine <name>] [--aot <module>] [--headless] <rom_file>", C8_PROG_NAME);
 
     const sf::Vector2u windowSize(C8_WINDOW_WIDTH<u32>, C8_WINDOW_HEIGHT<u32>);
     const sf::Vector2u targetSize(C8_SCREEN_BUFFER_WIDTH<u32>, C8_SCREEN_BUFFER_HEIGHT<u32>);
@@ -25,22 +31,39 @@ Client::Client(i32 argc, char** argv) noexcept
     m_Window.setVerticalSyncEnabled(true);
     m_Window.setMinimumSize(windowSize);
 
-    m_Renderer.Init(windowSize, targetSize);
-
-    if (argc > 1)
+    m_Renderer.Init(CreateSFMLBackend(m_Window, targetSize));
+    m_Renderer.SetDebugOverlay(options.DebugOverlay);
+    m_Renderer.SetDebugOverlayRate(options.DebugOverlayRate);
+
+    m_Chip8.SetEngine(options.Engine);
+    m_Chip8.SetTierThresholds(options.Thresholds);
+    m_Chip8.SetTiming(options.Timing);
+    m_Chip8.SetInstructionsPerFrame(options.InstructionsPerFrame);
+    m_Chip8.SetTurbo(options.Turbo);
+    m_Chip8.SetTurboFrames(options.TurboFrames);
+    if (!options.ROMPath.empty())
     {
-        if (m_Chip8.LoadROM(argv[1]))
+        if (m_Chip8.LoadROM(options.ROMPath))
         {
             const ROM& rom = m_Chip8.GetROM();
             m_Window.setTitle(std::format("{} - {}", C8_WINDOW_TITLE, rom.GetName().data()));
+
+            if (!options.AOTPath.empty() && !m_Chip8.LoadAOT(options.AOTPath))
+                C8_LOG_WARNING("Falling back to the interpreter");
+
+            if (options.CalibrateEngine)
+                m_Chip8.CalibrateEngine();
         }
     }
 
+    m_Chip8.Start(options.PinCore);
+
     m_Clock.start();
 }
 
 Client::~Client() noexcept
 {
+    m_Chip8.Stop();
     m_Window.close();
     m_Renderer.Shutdown();
 }
@@ -51,14 +74,24 @@ void Client::Run() noexcept
     while (m_IsRunning)
     {
         const sf::Time t0 = m_Clock.getElapsedTime();
+        const u64 allocations = GetThreadAllocations();
         while (const auto e = m_Window.pollEvent())
             OnEvent(*e);
 
         OnUpdate();
         OnRender();
 
+        // Nothing waits for vsync when the frame was not presented, so the
+        // loop sleeps the rest of the frame instead of spinning
+        if (!m_Presented)
+        {
+            const sf::Time busy = m_Clock.getElapsedTime() - t0;
+            sf::sleep(sf::seconds(C8_TICK_RATE) - busy);
+        }
+
         const sf::Time elapsed = m_Clock.getElapsedTime() - t0;
         m_DeltaTime = elapsed.asSeconds();
+        m_FrameAllocations = GetThreadAllocations() - allocations;
     }
 }
 
@@ -93,20 +126,37 @@ void Client::OnEvent(const sf::Event& event) noexcept
         {
             m_IsRunning = false;
         }
+        else if (key->code == C8_TURBO_KEY)
+        {
+            m_Chip8.SetTurboHeld(true);
+        }
+        else if (const std::optional<u8> k = GetKeypadKey(key->code))
+        {
+            m_Chip8.OnKey(*k, true);
+        }
+    }
+    else if (const auto keyRelease = event.getIf<sf::Event::KeyReleased>())
+    {
+        if (keyRelease->code == C8_TURBO_KEY)
+            m_Chip8.SetTurboHeld(false);
+        else if (const std::optional<u8> k = GetKeypadKey(keyRelease->code))
+            m_Chip8.OnKey(*k, false);
     }
     else if (const auto resizeData = event.getIf<sf::Event::Resized>())
     {
         const sf::Vector2u newSize = resizeData->size;
         OnResize(newSize);
     }
-
-    m_Chip8.OnEvent(event);
+    else if (event.is<sf::Event::FocusGained>())
+    {
+        m_Renderer.Invalidate();
+    }
 }
 
 void Client::OnUpdate() noexcept
 {
     const sf::Time t0 = m_Clock.getElapsedTime();
-    m_Chip8.OnUpdate(m_DeltaTime);
+    m_Chip8.OnUpdate();
 
     const sf::Time elapsed = m_Clock.getElapsedTime() - t0;
     m_UpdateTime = elapsed.asSeconds();
@@ -116,8 +166,8 @@ void Client::OnRender() noexcept
 {
     const sf::Time t0 = m_Clock.getElapsedTime();
 
-    RenderContext ctx = m_Renderer.Begin();
-    if (ctx.DebugOverlayEnabled())
+    RenderContext ctx = m_Renderer.Begin(m_DeltaTime);
+    if (ctx.DebugOverlayDue())
     {
         const sf::Vector2u windowSize = m_Window.getSize();
         const i32 fps = static_cast<i32>(1.0f / m_DeltaTime);
@@ -128,9 +178,15 @@ void Client::OnRender() noexcept
         ctx.AddDebugText(" RESOLUTION: {}x{}", windowSize.x, windowSize.y);
         ctx.AddDebugText(" UPDATE TIME: {:.5f}MS", m_UpdateTime * 1000.0f);
         ctx.AddDebugText(" RENDER TIME: {:.5f}MS", m_RenderTime * 1000.0f);
+
+        const RenderStats& stats = m_Renderer.GetStats();
+        const float changed = stats.Presented > 0 ? 100.0f * static_cast<float>(stats.Changed) / static_cast<float>(stats.Presented) : 0.0f;
+        ctx.AddDebugText(" FRAMES CHANGED: {}/{} PRESENTED ({:.1f}%)", stats.Changed, stats.Presented, changed);
+        if constexpr (C8_ALLOCATIONS_COUNTED)
+            ctx.AddDebugText(" ALLOCATIONS: {} LAST FRAME", m_FrameAllocations);
     }
-    m_Chip8.OnRender(ctx);
-    m_Renderer.End(std::move(ctx), m_Window);
+    DrawMachine(ctx, m_Chip8.GetSnapshot());
+    m_Presented = m_Renderer.End(std::move(ctx));
 
     const sf::Time elapsed = m_Clock.getElapsedTime() - t0;
     m_RenderTime = elapsed.asSeconds();
@@ -139,7 +195,7 @@ void Client::OnRender() noexcept
 void Client::OnResize(sf::Vector2u newSize) noexcept
 {
     m_Window.setSize(newSize);
-    m_Renderer.OnResize(newSize);
+    m_Renderer.OnResize(newSize.x, newSize.y);
     C8_LOG_WARNING("Window resized to {}x{}", newSize.x, newSize.y);
 }
 
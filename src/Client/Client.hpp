@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Options.hpp"
+
 #include "Core/Types.hpp"
 
 #include "Emulator/Chip8.hpp"
@@ -14,7 +16,7 @@ namespace c8emu {
 class Client final
 {
 public:
-    Client(i32 argc, char** argv) noexcept;
+    explicit Client(const Options& options) noexcept;
     ~Client() noexcept;
 
     void Run() noexcept;
@@ -30,10 +32,12 @@ private:
     Renderer         m_Renderer{};
     sf::RenderWindow m_Window{};
     sf::Clock        m_Clock{};
+    u64              m_FrameAllocations{}; // On this thread, only counted with C8_COUNT_ALLOCATIONS
     float            m_UpdateTime{};
     float            m_RenderTime{};
     float            m_DeltaTime{};
     bool             m_IsRunning{};
+    bool             m_Presented{};
 };
 
 }
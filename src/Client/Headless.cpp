@@ -0,0 +1,232 @@
+#include "Config.hpp"
+#include "Headless.hpp"
+
+#include "Core/Allocations.hpp"
+#include "Core/Debug.hpp"
+
+#include "Emulator/Chip8.hpp"
+#include "Emulator/CPU.hpp"
+#include "Emulator/RAM.hpp"
+#include "Emulator/ROM.hpp"
+
+#include "Renderer/CPUBackend.hpp"
+#include "Renderer/MachineView.hpp"
+#include "Renderer/Renderer.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <print>
+#include <span>
+#include <thread>
+
+namespace c8emu {
+
+// FNV-1a over one byte per pixel, as the display used to be stored, so that
+// hashes of known good runs stay valid
+[[nodiscard]] static u64 HashVideo(const CPUData::VideoBuffer& video) noexcept
+{
+    u64 hash = 0xCBF29CE484222325;
+    for (size_t y{}; y < C8_SCREEN_BUFFER_HEIGHT<size_t>; y++)
+    {
+        for (size_t x{}; x < C8_SCREEN_BUFFER_WIDTH<size_t>; x++)
+        {
+            hash ^= IsPixelLit(video, x, y) ? 0xFF : 0x00;
+            hash *= 0x00000100000001B3;
+        }
+    }
+
+    return hash;
+}
+
+[[nodiscard]] static u64 HashImage(std::span<const u8> pixels) noexcept
+{
+    u64 hash = 0xCBF29CE484222325;
+    for (const u8 byte : pixels)
+    {
+        hash ^= static_cast<u64>(byte);
+        hash *= 0x00000100000001B3;
+    }
+
+    return hash;
+}
+
+[[nodiscard]] static std::unique_ptr<RenderBackend> CreateHeadlessBackend(BackendID id) noexcept
+{
+    switch (id)
+    {
+        case BackendID::CPU:
+            return CreateCPUBackend(C8_WINDOW_WIDTH<u32>, C8_WINDOW_HEIGHT<u32>, PixelFormat::RGBA8);
+        case BackendID::CPU_MONO:
+            return CreateCPUBackend(C8_WINDOW_WIDTH<u32>, C8_WINDOW_HEIGHT<u32>, PixelFormat::MONO1);
+        default:
+            return CreateNullBackend();
+    }
+}
+
+// The rates shown on the overlay are averaged over the whole run
+static void FillSnapshot(FrameSnapshot& frame, const CPU& cpu, u64 frames, double secs) noexcept
+{
+    const ExecStats& stats = cpu.GetExecStats();
+
+    frame.CPU = cpu.GetData();
+    frame.Tiers = cpu.GetTierStats();
+    frame.Engine = cpu.GetEngine();
+    frame.Timing = cpu.GetTiming();
+    frame.InstructionsPerFrame = cpu.GetInstructionsPerFrame();
+    frame.IPS = secs > 0.0 ? static_cast<float>(static_cast<double>(stats.Retired) / secs) : 0.0f;
+    frame.IdleShare = stats.Retired > 0 ? 100.0f * static_cast<float>(stats.Skipped) / static_cast<float>(stats.Retired) : 0.0f;
+    frame.Speed = secs > 0.0 ? static_cast<float>(static_cast<double>(frames) * C8_TICK_RATE / secs) : 0.0f;
+    frame.WaitingForKey = cpu.IsWaitingForKey();
+    frame.Turbo = true;
+}
+
+i32 RunHeadless(const Options& options) noexcept
+{
+    ROM rom{};
+    if (!rom.Load(options.ROMPath))
+    {
+        std::println(std::cerr, "Failed to load ROM: {}", options.ROMPath.string());
+        return EXIT_FAILURE;
+    }
+
+    // The CPU carries all of its code caches, which is a lot for a stack
+    const std::unique_ptr<RAM> ram = std::make_unique<RAM>();
+    const std::unique_ptr<CPU> cpu = std::make_unique<CPU>();
+    ram->LoadROM(rom);
+
+    cpu->SetEngine(options.Engine);
+    cpu->SetTierThresholds(options.Thresholds);
+    cpu->SetTiming(options.Timing);
+    cpu->SetInstructionsPerFrame(options.InstructionsPerFrame);
+
+    if (!options.AOTPath.empty() && !cpu->LoadAOT(options.AOTPath, *ram))
+        C8_LOG_WARNING("Falling back to the interpreter");
+
+    if (options.CalibrateEngine)
+        (void)cpu->Calibrate(*ram);
+
+    // Drawing every frame is not free either, so it only happens on request
+    Renderer renderer{};
+    std::unique_ptr<FrameSnapshot> snapshot{};
+    if (options.Render)
+    {
+        renderer.Init(CreateHeadlessBackend(*options.Render));
+        renderer.SetDebugOverlay(options.DebugOverlay);
+        renderer.SetDebugOverlayRate(options.DebugOverlayRate);
+        snapshot = std::make_unique<FrameSnapshot>();
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    const u64 frames = options.Frames > 0 || options.Seconds > 0.0f ? options.Frames : C8_HEADLESS_DEFAULT_FRAMES;
+    const std::chrono::duration<float> seconds(options.Seconds);
+
+    // Time limits are only checked every so often, the clock is not free
+    constexpr u64 CLOCK_INTERVAL = 64;
+
+    // Code caches and the overlay fill up over the first frames, anything
+    // allocated after that happens again and again
+    constexpr u64 WARM_UP_FRAMES = 120;
+
+    u64 warmAllocations{};
+    u64 lastAllocations{};
+    u64 firstAllocatingFrame{};
+
+    const Clock::time_point t0 = Clock::now();
+    u64 frame{};
+    while (frames == 0 || frame < frames)
+    {
+        if (options.Seconds > 0.0f && frame % CLOCK_INTERVAL == 0 && Clock::now() - t0 >= seconds)
+            break;
+
+        cpu->Step(*ram);
+        frame++;
+
+        if (snapshot)
+        {
+            const std::chrono::duration<double> elapsed = Clock::now() - t0;
+            FillSnapshot(*snapshot, *cpu, frame, elapsed.count());
+            cpu->ClearDirtyRows();
+
+            // Frames identical to the last one are skipped by the renderer.
+            // The overlay is paced in emulated time, so runs stay repeatable.
+            RenderContext ctx = renderer.Begin(C8_TICK_RATE);
+            DrawMachine(ctx, *snapshot);
+            renderer.End(std::move(ctx));
+        }
+
+        // Nothing is ever going to press a key, but there is no need to
+        // hog the core while the timers run down either
+        if (cpu->IsWaitingForKey())
+            std::this_thread::yield();
+
+        const u64 allocations = GetThreadAllocations();
+        if (frame == WARM_UP_FRAMES)
+            warmAllocations = allocations;
+        else if (frame > WARM_UP_FRAMES && allocations != lastAllocations && firstAllocatingFrame == 0)
+            firstAllocatingFrame = frame;
+
+        lastAllocations = allocations;
+    }
+
+    const u64 lateAllocations = frame > WARM_UP_FRAMES ? lastAllocations - warmAllocations : 0;
+
+    const std::chrono::duration<double> elapsed = Clock::now() - t0;
+    const ExecStats& stats = cpu->GetExecStats();
+    const double secs = elapsed.count();
+
+    std::println("rom:          {}", rom.GetName());
+    std::println("engine:       {}", GetEngineName(cpu->GetEngine()));
+    if (options.Render)
+    {
+        const RenderStats& renderStats = renderer.GetStats();
+        std::println("render:       {}", GetBackendName(*options.Render));
+        std::println("presented:    {} of {} frames ({} changed the display)", renderStats.Presented, renderStats.Frames, renderStats.Changed);
+    }
+    std::println("frames:       {}", frame);
+    std::println("instructions: {} ({} skipped idle)", stats.Retired, stats.Skipped);
+    std::println("elapsed:      {:.3f} s", secs);
+    std::println("ips:          {:.0f}", secs > 0.0 ? static_cast<double>(stats.Retired) / secs : 0.0);
+    std::println("fps:          {:.0f}", secs > 0.0 ? static_cast<double>(frame) / secs : 0.0);
+    std::println("ns/instr:     {:.2f}", stats.Retired > 0 ? secs * 1e9 / static_cast<double>(stats.Retired) : 0.0);
+
+    if constexpr (C8_ALLOCATIONS_COUNTED)
+        std::println("allocations:  {} after {} warm-up frames", lateAllocations, WARM_UP_FRAMES);
+    if (options.HashVideo)
+        std::println("video hash:   {:016x}", HashVideo(cpu->GetData().Video));
+
+    if (options.HashVideo && options.Render && *options.Render != BackendID::NONE)
+    {
+        const CPUBackend& backend = static_cast<const CPUBackend&>(renderer.GetBackend());
+        std::println("image hash:   {:016x}", HashImage(backend.GetPixels()));
+    }
+
+    renderer.Shutdown();
+
+    if (options.CheckAllocations)
+    {
+        if constexpr (!C8_ALLOCATIONS_COUNTED)
+        {
+            std::println(std::cerr, "Allocations are not counted, build with C8_COUNT_ALLOCATIONS");
+            return EXIT_FAILURE;
+        }
+
+        if (frame <= WARM_UP_FRAMES)
+        {
+            std::println(std::cerr, "Too few frames to check allocations, at least {} are needed", WARM_UP_FRAMES + 1);
+            return EXIT_FAILURE;
+        }
+
+        if (lateAllocations > 0)
+        {
+            std::println(std::cerr, "{} allocations after warm-up, the first in frame {}", lateAllocations, firstAllocatingFrame);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Options.hpp"
+
+#include "Core/Types.hpp"
+
+namespace c8emu {
+
+constexpr u64 C8_HEADLESS_DEFAULT_FRAMES = 3600; // One emulated minute, if neither frames nor seconds are given
+
+// Runs the ROM without a window or any pacing for a number of frames or
+// seconds, then prints the measured throughput. Returns the exit code.
+[[nodiscard]] i32 RunHeadless(const Options& options) noexcept;
+
+}
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "Core/Types.hpp"
+
+#include "Emulator/Spec.hpp"
+
 #include <SFML/Window/Keyboard.hpp>
 
+#include <optional>
+
 namespace c8emu {
 
 constexpr sf::Keyboard::Key C8_KEYS[] =
@@ -12,4 +18,16 @@ constexpr sf::Keyboard::Key C8_KEYS[] =
     sf::Keyboard::Key::Num4,    sf::Keyboard::Key::R,    sf::Keyboard::Key::F,    sf::Keyboard::Key::V,
 };
 
+// Runs the emulation as fast as possible for as long as it is held
+constexpr sf::Keyboard::Key C8_TURBO_KEY = sf::Keyboard::Key::Tab;
+
+[[nodiscard]] constexpr std::optional<u8> GetKeypadKey(sf::Keyboard::Key code) noexcept
+{
+    for (u8 k{}; k < C8_NUM_KEYS; k++)
+        if (code == C8_KEYS[k])
+            return k;
+
+    return std::nullopt;
+}
+
 }
@@ -0,0 +1,247 @@
+#include "Options.hpp"
+
+#include "Core/Debug.hpp"
+
+#include <charconv>
+#include <optional>
+#include <string_view>
+
+namespace c8emu {
+
+// Parses "<translated>,<native>"
+static std::optional<TierThresholds> ParseTierThresholds(std::string_view value) noexcept
+{
+    const size_t comma = value.find(',');
+    if (comma == std::string_view::npos)
+        return std::nullopt;
+
+    const std::string_view first = value.substr(0, comma);
+    const std::string_view second = value.substr(comma + 1);
+
+    TierThresholds thresholds{};
+    const auto [firstEnd, firstErr] = std::from_chars(first.data(), first.data() + first.size(), thresholds.Translated);
+    const auto [secondEnd, secondErr] = std::from_chars(second.data(), second.data() + second.size(), thresholds.Native);
+    if (firstErr != std::errc{} || firstEnd != first.data() + first.size() ||
+        secondErr != std::errc{} || secondEnd != second.data() + second.size())
+        return std::nullopt;
+
+    return thresholds;
+}
+
+Options Options::Parse(i32 argc, char** argv) noexcept
+{
+    Options options{};
+    for (i32 i = 1; i < argc; i++)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--engine")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view name = argv[++i];
+            options.CalibrateEngine = name == "auto";
+            if (options.CalibrateEngine)
+                continue;
+
+            if (const auto engine = ParseEngineID(name))
+                options.Engine = *engine;
+            else
+                C8_LOG_WARNING("Unknown engine: {}", name);
+        }
+        else if (arg == "--tier-thresholds")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view value = argv[++i];
+            if (const auto thresholds = ParseTierThresholds(value))
+                options.Thresholds = *thresholds;
+            else
+                C8_LOG_WARNING("Invalid tier thresholds: {}", value);
+        }
+        else if (arg == "--ipf")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view value = argv[++i];
+
+            u32 count{};
+            const auto [end, err] = std::from_chars(value.data(), value.data() + value.size(), count);
+            if (err == std::errc{} && end == value.data() + value.size() && count > 0)
+                options.InstructionsPerFrame = count;
+            else
+                C8_LOG_WARNING("Invalid instructions per frame: {}", value);
+        }
+        else if (arg == "--timing")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view name = argv[++i];
+            if (const auto timing = ParseTimingModel(name))
+                options.Timing = *timing;
+            else
+                C8_LOG_WARNING("Unknown timing model: {}", name);
+        }
+        else if (arg == "--turbo")
+        {
+            options.Turbo = true;
+        }
+        else if (arg == "--turbo-frames")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view value = argv[++i];
+
+            u32 frames{};
+            const auto [end, err] = std::from_chars(value.data(), value.data() + value.size(), frames);
+            if (err == std::errc{} && end == value.data() + value.size())
+                options.TurboFrames = frames;
+            else
+                C8_LOG_WARNING("Invalid turbo frame count: {}", value);
+        }
+        else if (arg == "--pin-core")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view value = argv[++i];
+
+            u32 core{};
+            const auto [end, err] = std::from_chars(value.data(), value.data() + value.size(), core);
+            if (err == std::errc{} && end == value.data() + value.size())
+                options.PinCore = core;
+            else
+                C8_LOG_WARNING("Invalid core: {}", value);
+        }
+        else if (arg == "--headless")
+        {
+            options.Headless = true;
+        }
+        else if (arg == "--frames")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view value = argv[++i];
+
+            u64 frames{};
+            const auto [end, err] = std::from_chars(value.data(), value.data() + value.size(), frames);
+            if (err == std::errc{} && end == value.data() + value.size())
+                options.Frames = frames;
+            else
+                C8_LOG_WARNING("Invalid frame count: {}", value);
+        }
+        else if (arg == "--seconds")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view value = argv[++i];
+
+            float seconds{};
+            const auto [end, err] = std::from_chars(value.data(), value.data() + value.size(), seconds);
+            if (err == std::errc{} && end == value.data() + value.size() && seconds >= 0.0f)
+                options.Seconds = seconds;
+            else
+                C8_LOG_WARNING("Invalid number of seconds: {}", value);
+        }
+        else if (arg == "--hash")
+        {
+            options.HashVideo = true;
+        }
+        else if (arg == "--check-allocations")
+        {
+            options.CheckAllocations = true;
+        }
+        else if (arg == "--render")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            // There is no window to draw to without a display
+            const std::string_view name = argv[++i];
+            const auto backend = ParseBackendID(name);
+            if (backend && *backend != BackendID::SFML)
+                options.Render = *backend;
+            else
+                C8_LOG_WARNING("Unknown headless render backend: {}", name);
+        }
+        else if (arg == "--overlay")
+        {
+            options.DebugOverlay = true;
+        }
+        else if (arg == "--overlay-rate")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            const std::string_view value = argv[++i];
+
+            float rate{};
+            const auto [end, err] = std::from_chars(value.data(), value.data() + value.size(), rate);
+            if (err == std::errc{} && end == value.data() + value.size() && rate >= 0.0f)
+                options.DebugOverlayRate = rate;
+            else
+                C8_LOG_WARNING("Invalid overlay refresh rate: {}", value);
+        }
+        else if (arg == "--aot")
+        {
+            if (i + 1 >= argc)
+            {
+                C8_LOG_WARNING("Missing value for {}", arg);
+                break;
+            }
+
+            // A recompiled module is only of use to its own engine
+            options.AOTPath = argv[++i];
+            options.Engine = EngineID::AOT;
+            options.CalibrateEngine = false;
+        }
+        else if (arg.starts_with("--"))
+        {
+            C8_LOG_WARNING("Unknown option: {}", arg);
+        }
+        else
+        {
+            options.ROMPath = arg;
+        }
+    }
+
+    return options;
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Core/Types.hpp"
+
+#include "Emulator/CPU.hpp"
+
+#include "Renderer/RenderBackend.hpp"
+
+#include <filesystem>
+#include <optional>
+
+namespace c8emu {
+
+struct Options final
+{
+public:
+    std::filesystem::path    ROMPath{};
+    std::filesystem::path    AOTPath{};
+    EngineID                 Engine{EngineID::LOOP};
+    TierThresholds           Thresholds{};
+    TimingModel              Timing{TimingModel::FIXED};
+    u32                      InstructionsPerFrame{C8_OPS_PER_CYCLE};
+    u32                      TurboFrames{};
+    std::optional<u32>       PinCore{};
+    std::optional<BackendID> Render{}; // Headless only, nothing is rendered if empty
+    u64                      Frames{};  // Headless only, zero for no limit
+    float                    Seconds{}; // Headless only, zero for no limit
+    float                    DebugOverlayRate{DebugOverlay::DEFAULT_REFRESH_RATE};
+    bool                     CalibrateEngine{};
+    bool                     Turbo{};
+    bool                     Headless{};
+    bool                     HashVideo{};
+    bool                     CheckAllocations{}; // Headless only, fails on any allocation after warm-up
+    bool                     DebugOverlay{};
+
+public:
+    [[nodiscard]] static Options Parse(i32 argc, char** argv) noexcept;
+};
+
+}
@@ -0,0 +1,103 @@
+#include "Allocations.hpp"
+#include "Platform.hpp"
+
+#if defined(C8_COUNT_ALLOCATIONS)
+#include <cstdlib>
+#include <new>
+
+#if defined(C8_PLATFORM_WINDOWS)
+#include <malloc.h>
+#endif
+#endif
+
+namespace c8emu {
+
+#if defined(C8_COUNT_ALLOCATIONS)
+
+// Per thread, so that the emulation thread doesn't show up in the UI's
+// numbers
+static thread_local u64 s_Allocations{};
+
+u64 GetThreadAllocations() noexcept
+{
+    return s_Allocations;
+}
+
+// Nothing here may allocate through operator new itself, and there are no
+// exceptions to throw, so running out of memory aborts
+[[nodiscard]] static void* Allocate(size_t size) noexcept
+{
+    s_Allocations++;
+    return std::malloc(size > 0 ? size : 1);
+}
+
+[[nodiscard]] static void* AllocateAligned(size_t size, std::align_val_t alignment) noexcept
+{
+    s_Allocations++;
+
+    const size_t align = static_cast<size_t>(alignment);
+    const size_t rounded = (size + align - 1) / align * align;
+#if defined(C8_PLATFORM_WINDOWS)
+    return _aligned_malloc(rounded > 0 ? rounded : align, align);
+#else
+    return std::aligned_alloc(align, rounded > 0 ? rounded : align);
+#endif
+}
+
+[[nodiscard]] static void* Require(void* ptr) noexcept
+{
+    if (!ptr)
+        std::abort();
+
+    return ptr;
+}
+
+static void FreeAligned(void* ptr) noexcept
+{
+#if defined(C8_PLATFORM_WINDOWS)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+#else
+
+u64 GetThreadAllocations() noexcept
+{
+    return 0;
+}
+
+#endif
+
+}
+
+#if defined(C8_COUNT_ALLOCATIONS)
+
+// --- replacement operators --------------------------------------------------
+
+void* operator new(std::size_t size) { return c8emu::Require(c8emu::Allocate(size)); }
+void* operator new[](std::size_t size) { return c8emu::Require(c8emu::Allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return c8emu::Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return c8emu::Allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return c8emu::Require(c8emu::AllocateAligned(size, alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return c8emu::Require(c8emu::AllocateAligned(size, alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return c8emu::AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return c8emu::AllocateAligned(size, alignment); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { c8emu::FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { c8emu::FreeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { c8emu::FreeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { c8emu::FreeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { c8emu::FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { c8emu::FreeAligned(ptr); }
+
+#endif
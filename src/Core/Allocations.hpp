@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Core/Types.hpp"
+
+namespace c8emu {
+
+#if defined(C8_COUNT_ALLOCATIONS)
+constexpr bool C8_ALLOCATIONS_COUNTED = true;
+#else
+constexpr bool C8_ALLOCATIONS_COUNTED = false;
+#endif
+
+// Heap allocations made through operator new by the calling thread so far.
+// Always zero unless built with C8_COUNT_ALLOCATIONS, which replaces the
+// global operators to count them.
+[[nodiscard]] u64 GetThreadAllocations() noexcept;
+
+}
@@ -43,7 +43,8 @@ enum class ErrorCode : u8
     FAILED_TO_READ_ROM,
     OUT_OF_MEMORY,
     FAILED_TO_LOAD_TARGET,
-    INVALID_ADDRESS_MODE,
+    FAILED_TO_PROTECT_CODE,
+    FAILED_TO_COMPILE_MODULE,
 };
 
 template<typename ... Args>
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Types.hpp"
+
+#include <cstddef>
+#include <iterator>
+
+namespace c8emu {
+
+// 8x8 glyphs for printable ASCII, one byte per row with the leftmost pixel in
+// the most significant bit. Rasterised from NINTENDO_NES_FONT_OTF, see
+// NintendoNESFont.hpp for its license. The font has no glyphs for most of
+// the punctuation, those were drawn to match.
+
+constexpr char   NINTENDO_NES_FONT_FIRST_CHAR = ' ';
+constexpr char   NINTENDO_NES_FONT_LAST_CHAR  = '~';
+constexpr size_t NINTENDO_NES_FONT_GLYPH_SIZE = 8;
+
+constexpr u8 NINTENDO_NES_FONT_BITMAP[][NINTENDO_NES_FONT_GLYPH_SIZE] =
+{
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x18, 0x3C, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18 }, // '!'
+    { 0x6C, 0x6C, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+    { 0x66, 0xFF, 0xFF, 0x66, 0x66, 0xFF, 0xFF, 0x66 }, // '#'
+    { 0x18, 0x3E, 0x60, 0x3C, 0x06, 0x7C, 0x18, 0x00 }, // '$'
+    { 0x62, 0x66, 0x0C, 0x18, 0x30, 0x66, 0x46, 0x00 }, // '%'
+    { 0x70, 0x88, 0x50, 0x20, 0x54, 0x88, 0x76, 0x00 }, // '&'
+    { 0x30, 0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '\''
+    { 0x0C, 0x18, 0x30, 0x30, 0x30, 0x18, 0x0C, 0x00 }, // '('
+    { 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x18, 0x30, 0x00 }, // ')'
+    { 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00 }, // '*'
+    { 0x00, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x00, 0x00 }, // '+'
+    { 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x40, 0x00 }, // ','
+    { 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x00, 0x00, 0x00 }, // '-'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x00 }, // '.'
+    { 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x00 }, // '/'
+    { 0x38, 0x4C, 0xC6, 0xC6, 0xC6, 0x64, 0x38, 0x00 }, // '0'
+    { 0x18, 0x38, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x00 }, // '1'
+    { 0x7C, 0xC6, 0x0E, 0x3C, 0x78, 0xE0, 0xFE, 0x00 }, // '2'
+    { 0x7E, 0x0C, 0x18, 0x3C, 0x06, 0xC6, 0x7C, 0x00 }, // '3'
+    { 0x1C, 0x3C, 0x6C, 0xCC, 0xFE, 0x0C, 0x0C, 0x00 }, // '4'
+    { 0xFC, 0xC0, 0xFC, 0x06, 0x06, 0xC6, 0x7C, 0x00 }, // '5'
+    { 0x3C, 0x60, 0xC0, 0xFC, 0xC6, 0xC6, 0x7C, 0x00 }, // '6'
+    { 0xFE, 0xC6, 0x0C, 0x18, 0x30, 0x30, 0x30, 0x00 }, // '7'
+    { 0x7C, 0xC6, 0xC6, 0x7C, 0xC6, 0xC6, 0x7C, 0x00 }, // '8'
+    { 0x7C, 0xC6, 0xC6, 0x7E, 0x06, 0x0C, 0x78, 0x00 }, // '9'
+    { 0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x00 }, // ':'
+    { 0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x30 }, // ';'
+    { 0x0C, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0C, 0x00 }, // '<'
+    { 0x00, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x00, 0x00 }, // '='
+    { 0x30, 0x18, 0x0C, 0x06, 0x0C, 0x18, 0x30, 0x00 }, // '>'
+    { 0x38, 0x44, 0x04, 0x08, 0x10, 0x00, 0x10, 0x00 }, // '?'
+    { 0x6C, 0xFE, 0xFE, 0xFE, 0x7C, 0x38, 0x10, 0x00 }, // '@'
+    { 0x38, 0x6C, 0xC6, 0xC6, 0xFE, 0xC6, 0xC6, 0x00 }, // 'A'
+    { 0xFC, 0xC6, 0xC6, 0xFC, 0xC6, 0xC6, 0xFC, 0x00 }, // 'B'
+    { 0x3C, 0x66, 0xC0, 0xC0, 0xC0, 0x66, 0x3C, 0x00 }, // 'C'
+    { 0xF8, 0xCC, 0xC6, 0xC6, 0xC6, 0xCC, 0xF8, 0x00 }, // 'D'
+    { 0xFE, 0xC0, 0xC0, 0xFC, 0xC0, 0xC0, 0xFE, 0x00 }, // 'E'
+    { 0xFE, 0xC0, 0xC0, 0xFC, 0xC0, 0xC0, 0xC0, 0x00 }, // 'F'
+    { 0x3E, 0x60, 0xC0, 0xCE, 0xC6, 0x66, 0x3E, 0x00 }, // 'G'
+    { 0xC6, 0xC6, 0xC6, 0xFE, 0xC6, 0xC6, 0xC6, 0x00 }, // 'H'
+    { 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x00 }, // 'I'
+    { 0x1E, 0x06, 0x06, 0x06, 0xC6, 0xC6, 0x7C, 0x00 }, // 'J'
+    { 0xC6, 0xCC, 0xD8, 0xF0, 0xF8, 0xDC, 0xCE, 0x00 }, // 'K'
+    { 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x7E, 0x00 }, // 'L'
+    { 0xC6, 0xEE, 0xFE, 0xFE, 0xD6, 0xC6, 0xC6, 0x00 }, // 'M'
+    { 0xC6, 0xE6, 0xF6, 0xFE, 0xDE, 0xCE, 0xC6, 0x00 }, // 'N'
+    { 0x7C, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0x7C, 0x00 }, // 'O'
+    { 0xFC, 0xC6, 0xC6, 0xC6, 0xFC, 0xC0, 0xC0, 0x00 }, // 'P'
+    { 0x7C, 0xC6, 0xC6, 0xC6, 0xD6, 0xCC, 0x7A, 0x00 }, // 'Q'
+    { 0xFC, 0xC6, 0xC6, 0xCE, 0xF8, 0xDC, 0xCE, 0x00 }, // 'R'
+    { 0x78, 0xCC, 0xC0, 0x7C, 0x06, 0xC6, 0x7C, 0x00 }, // 'S'
+    { 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00 }, // 'T'
+    { 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0x7C, 0x00 }, // 'U'
+    { 0xC6, 0xC6, 0xC6, 0xEE, 0x7C, 0x38, 0x10, 0x00 }, // 'V'
+    { 0xC6, 0xC6, 0xD6, 0xFE, 0xFE, 0xEE, 0xC6, 0x00 }, // 'W'
+    { 0xC6, 0xEE, 0x7C, 0x38, 0x7C, 0xEE, 0xC6, 0x00 }, // 'X'
+    { 0x66, 0x66, 0x66, 0x3C, 0x18, 0x18, 0x18, 0x00 }, // 'Y'
+    { 0xFE, 0x0E, 0x1C, 0x38, 0x70, 0xE0, 0xFE, 0x00 }, // 'Z'
+    { 0x3C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x00 }, // '['
+    { 0xC0, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x00 }, // '\\'
+    { 0x3C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x3C, 0x00 }, // ']'
+    { 0x18, 0x3C, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '^'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x00 }, // '_'
+    { 0x30, 0x18, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '`'
+    { 0x00, 0x30, 0x08, 0x38, 0x48, 0x48, 0x34, 0x00 }, // 'a'
+    { 0x00, 0x20, 0x20, 0x38, 0x24, 0x24, 0x38, 0x00 }, // 'b'
+    { 0x00, 0x00, 0x38, 0x40, 0x40, 0x40, 0x38, 0x00 }, // 'c'
+    { 0x00, 0x04, 0x04, 0x1C, 0x24, 0x24, 0x1C, 0x00 }, // 'd'
+    { 0x00, 0x00, 0x38, 0x44, 0x78, 0x40, 0x3C, 0x00 }, // 'e'
+    { 0x00, 0x18, 0x10, 0x3C, 0x10, 0x10, 0x10, 0x00 }, // 'f'
+    { 0x00, 0x30, 0x48, 0x3A, 0x0C, 0x14, 0x08, 0x00 }, // 'g'
+    { 0x00, 0x20, 0x20, 0x38, 0x24, 0x24, 0x24, 0x00 }, // 'h'
+    { 0x00, 0x00, 0x10, 0x00, 0x10, 0x10, 0x10, 0x00 }, // 'i'
+    { 0x00, 0x08, 0x00, 0x08, 0x08, 0x48, 0x30, 0x00 }, // 'j'
+    { 0x00, 0x40, 0x40, 0x48, 0x50, 0x70, 0x4C, 0x00 }, // 'k'
+    { 0x00, 0x08, 0x14, 0x14, 0x14, 0x08, 0x16, 0x00 }, // 'l'
+    { 0x00, 0x00, 0x28, 0x54, 0x54, 0x54, 0x54, 0x00 }, // 'm'
+    { 0x00, 0x00, 0x30, 0x48, 0x48, 0x48, 0x48, 0x00 }, // 'n'
+    { 0x00, 0x00, 0x30, 0x48, 0x48, 0x48, 0x30, 0x00 }, // 'o'
+    { 0x00, 0x38, 0x24, 0x24, 0x38, 0x20, 0x20, 0x00 }, // 'p'
+    { 0x00, 0x30, 0x48, 0x48, 0x38, 0x0A, 0x04, 0x00 }, // 'q'
+    { 0x00, 0x00, 0x60, 0x1C, 0x10, 0x10, 0x10, 0x00 }, // 'r'
+    { 0x00, 0x00, 0x38, 0x40, 0x38, 0x04, 0x78, 0x00 }, // 's'
+    { 0x00, 0x20, 0x70, 0x20, 0x20, 0x20, 0x18, 0x00 }, // 't'
+    { 0x00, 0x00, 0x48, 0x48, 0x48, 0x48, 0x34, 0x00 }, // 'u'
+    { 0x00, 0x00, 0x44, 0x44, 0x28, 0x38, 0x10, 0x00 }, // 'v'
+    { 0x00, 0x00, 0x54, 0x54, 0x54, 0x54, 0x28, 0x00 }, // 'w'
+    { 0x00, 0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00 }, // 'x'
+    { 0x00, 0x24, 0x24, 0x1C, 0x04, 0x24, 0x18, 0x00 }, // 'y'
+    { 0x00, 0x00, 0x7C, 0x08, 0x10, 0x20, 0x7C, 0x00 }, // 'z'
+    { 0x0E, 0x18, 0x18, 0x70, 0x18, 0x18, 0x0E, 0x00 }, // '{'
+    { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00 }, // '|'
+    { 0x70, 0x18, 0x18, 0x0E, 0x18, 0x18, 0x70, 0x00 }, // '}'
+    { 0x00, 0x00, 0x76, 0xDC, 0x00, 0x00, 0x00, 0x00 }, // '~'
+};
+
+static_assert(std::size(NINTENDO_NES_FONT_BITMAP) == NINTENDO_NES_FONT_LAST_CHAR - NINTENDO_NES_FONT_FIRST_CHAR + 1);
+
+// Anything outside of the table is drawn as '?'
+[[nodiscard]] constexpr const u8* GetGlyph(char c) noexcept
+{
+    if (c < NINTENDO_NES_FONT_FIRST_CHAR || c > NINTENDO_NES_FONT_LAST_CHAR)
+        c = '?';
+
+    return NINTENDO_NES_FONT_BITMAP[c - NINTENDO_NES_FONT_FIRST_CHAR];
+}
+
+}
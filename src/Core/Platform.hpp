@@ -43,3 +43,9 @@
 #define UNUSED __pragma(warning(suppress:4100))
 #define UNREACHABLE() __assume(false)
 #endif
+
+// --- compiler extensions ----------------------------------------------------
+
+#if defined(C8_COMPILER_GCC) || defined(C8_COMPILER_CLANG)
+#define C8_HAS_COMPUTED_GOTO
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Core/Types.hpp"
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+namespace c8emu {
+
+// Bounded lock-free queue between exactly one producer thread and one
+// consumer thread
+template<typename T, size_t N>
+    requires (N > 0 && (N & (N - 1)) == 0)
+class SPSCQueue final
+{
+public:
+    constexpr SPSCQueue() noexcept = default;
+
+    // Producer side, fails if the queue is full
+    [[nodiscard]] inline bool Push(const T& value) noexcept
+    {
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head - m_Tail.load(std::memory_order_acquire) == N)
+            return false;
+
+        m_Items[head & (N - 1)] = value;
+        m_Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    [[nodiscard]] inline std::optional<T> Pop() noexcept
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail == m_Head.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        const T value = m_Items[tail & (N - 1)];
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return value;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    // Each index is written by one side only, so they get their own cache
+    // lines to keep the two threads from contending over them
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Head{};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Tail{};
+    std::array<T, N>                             m_Items{};
+};
+
+}
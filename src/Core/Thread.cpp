@@ -0,0 +1,37 @@
+#include "Thread.hpp"
+#include "Platform.hpp"
+
+#if defined(C8_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(C8_PLATFORM_WINDOWS)
+#include <windows.h>
+#endif
+
+namespace c8emu {
+
+bool PinThread(std::jthread& thread, u32 core) noexcept
+{
+#if defined(C8_PLATFORM_LINUX)
+    if (core >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t set{};
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#elif defined(C8_PLATFORM_WINDOWS)
+    if (core >= sizeof(DWORD_PTR) * 8)
+        return false;
+
+    const DWORD_PTR mask = static_cast<DWORD_PTR>(1) << core;
+    return SetThreadAffinityMask(thread.native_handle(), mask) != 0;
+#else
+    // macOS only offers affinity hints, not pinning
+    (void)thread;
+    (void)core;
+    return false;
+#endif
+}
+
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Core/Types.hpp"
+
+#include <thread>
+
+namespace c8emu {
+
+// Restricts `thread` to the given logical core, returns false where that
+// isn't supported or the core doesn't exist
+[[nodiscard]] bool PinThread(std::jthread& thread, u32 core) noexcept;
+
+}
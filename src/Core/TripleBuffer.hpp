@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core/Types.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace c8emu {
+
+// Hands the latest of a stream of values from one producer thread to one
+// consumer thread without either side ever waiting on the other. Values the
+// consumer didn't get around to are overwritten.
+template<typename T>
+class TripleBuffer final
+{
+public:
+    constexpr TripleBuffer() noexcept = default;
+
+    // Producer side, Publish() returns whether it replaced a value the
+    // consumer never picked up. That value is the new back buffer.
+    [[nodiscard]] constexpr T& GetBackBuffer() noexcept { return m_Buffers[m_Back]; }
+    inline bool Publish() noexcept
+    {
+        const u8 middle = m_Middle.exchange(static_cast<u8>(m_Back | FRESH), std::memory_order_acq_rel);
+        m_Back = middle & INDEX;
+        return middle & FRESH;
+    }
+
+    // Consumer side, returns whether a new value was picked up
+    inline bool Consume() noexcept
+    {
+        if (!(m_Middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+
+        m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    [[nodiscard]] constexpr T& GetFrontBuffer() noexcept { return m_Buffers[m_Front]; }
+    [[nodiscard]] constexpr const T& GetFrontBuffer() const noexcept { return m_Buffers[m_Front]; }
+
+private:
+    static constexpr u8 INDEX = 0x03;
+    static constexpr u8 FRESH = 0x04; // Set while the middle buffer holds a value not consumed yet
+
+    std::array<T, 3> m_Buffers{};
+    std::atomic<u8>  m_Middle{1};
+    u8               m_Back{0};
+    u8               m_Front{2};
+};
+
+}
@@ -0,0 +1,152 @@
+#include "AOT.hpp"
+#include "Blocks.hpp"
+#include "CPU.hpp"
+#include "CodeCache.hpp"
+#include "Executors.hpp"
+
+#include "Core/Debug.hpp"
+
+#if !defined(C8_PLATFORM_WINDOWS)
+#include <dlfcn.h>
+#endif
+
+#include <cstring>
+
+namespace c8emu {
+
+// --- module -----------------------------------------------------------------
+
+AotModule::~AotModule() noexcept
+{
+    Unload();
+}
+
+bool AotModule::Load(const std::filesystem::path& filePath, const RAM& ram) noexcept
+{
+    Unload();
+
+#if defined(C8_PLATFORM_WINDOWS)
+    C8_LOG_WARNING("Recompiled modules are not supported on this platform: {}", filePath.string());
+    (void)ram;
+    return false;
+#else
+    void* handle = dlopen(filePath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+    {
+        C8_LOG_ERROR("Couldn't load recompiled module: {}", dlerror());
+        return false;
+    }
+
+    const auto* manifest = static_cast<const AotManifest*>(dlsym(handle, "c8aot_manifest"));
+    if (!manifest)
+    {
+        C8_LOG_ERROR("Not a recompiled module: {}", filePath.string());
+        dlclose(handle);
+        return false;
+    }
+
+    if (manifest->AbiVersion != C8_AOT_ABI_VERSION || manifest->CPUDataSize != sizeof(CPUData) || manifest->RAMSize != sizeof(RAM))
+    {
+        C8_LOG_ERROR("Recompiled module was built for a different version of c8emu: {}", filePath.string());
+        dlclose(handle);
+        return false;
+    }
+
+    // The module must have been built from the ROM that is actually loaded
+    bool matches = manifest->ImageSize <= C8_MAX_ROM_SIZE;
+    for (u32 i{}; matches && i < manifest->ImageSize; i++)
+        matches = ram[static_cast<Address>(C8_ADDR_ROM + i)] == manifest->Image[i];
+
+    if (!matches)
+    {
+        C8_LOG_ERROR("Recompiled module doesn't match the loaded ROM: {}", filePath.string());
+        dlclose(handle);
+        return false;
+    }
+
+    manifest->Bind(C8_EXECUTORS);
+    for (u32 i{}; i < manifest->NumBlocks; i++)
+    {
+        const AotBlock& block = manifest->Blocks[i];
+        m_Entries[static_cast<size_t>(block.Entry)] = &block;
+
+        for (size_t j{}; j < 2 * static_cast<size_t>(block.Length); j++)
+            m_CodeMap[static_cast<size_t>(block.Entry) + j]++;
+    }
+
+    m_Handle = handle;
+    m_Manifest = manifest;
+
+    C8_LOG_INFO("Recompiled module loaded with {} blocks: {}", manifest->NumBlocks, filePath.filename().string());
+    return true;
+#endif
+}
+
+void AotModule::Unload() noexcept
+{
+#if !defined(C8_PLATFORM_WINDOWS)
+    if (m_Handle)
+        dlclose(m_Handle);
+#endif
+
+    m_Handle = nullptr;
+    m_Manifest = nullptr;
+    m_Entries.fill(nullptr);
+    m_CodeMap.fill(0);
+}
+
+void AotModule::Invalidate(const RAM& ram, DirtyRange range) noexcept
+{
+    for (Address addr = range.Begin; addr < range.End; addr++)
+    {
+        const size_t offset = static_cast<size_t>(addr & 0x0FFF);
+        if (m_CodeMap[offset] == 0)
+            continue;
+
+        // Stores that leave the code as it was (like loading the ROM itself)
+        // don't invalidate anything
+        if (ram[addr] == m_Manifest->Image[offset - C8_ADDR_ROM])
+            continue;
+
+        for (size_t entry{}; entry < C8_MEMORY_SIZE; entry++)
+        {
+            const AotBlock* block = m_Entries[entry];
+            if (block && offset - entry < 2 * static_cast<size_t>(block->Length))
+                Evict(entry);
+        }
+    }
+}
+
+void AotModule::Evict(size_t entry) noexcept
+{
+    const AotBlock* block = m_Entries[entry];
+    for (size_t i{}; i < 2 * static_cast<size_t>(block->Length); i++)
+        m_CodeMap[entry + i]--;
+
+    m_Entries[entry] = nullptr;
+}
+
+// --- engine -----------------------------------------------------------------
+
+u32 RunAOT(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept
+{
+    u32 retired{};
+    while (retired < count && cpu.Wait != KeyWait::WAITING)
+    {
+        code.Sync(ram);
+
+        if (const AotBlock* block = code.Static.Lookup(cpu.PC))
+        {
+            retired += block->Proc(&cpu, &ram, count - retired);
+            continue;
+        }
+
+        // Anything that wasn't reached statically, or has been overwritten
+        const Block& block = code.Blocks.Lookup(ram, cpu.PC);
+        retired += ExecuteBlock(cpu, ram, block, count - retired);
+    }
+
+    return retired;
+}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Instructions.hpp"
+#include "RAM.hpp"
+#include "Spec.hpp"
+
+#include "Core/Platform.hpp"
+
+#include <array>
+#include <filesystem>
+
+#if defined(C8_COMPILER_MSVC)
+#define C8_AOT_EXPORT __declspec(dllexport)
+#else
+#define C8_AOT_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace c8emu {
+
+// Forward declerations
+struct CPUData;
+struct CodeCache;
+
+// Bumped whenever anything a recompiled module depends on changes shape
+constexpr u32 C8_AOT_ABI_VERSION = 5;
+
+// Runs at most `count` instructions of a recompiled block and returns how
+// many were run
+using AotProc = u32(*)(CPUData* cpu, RAM* ram, u32 count) noexcept;
+
+struct AotBlock final
+{
+public:
+    AotProc Proc{};
+    Address Entry{};
+    u8      Length{};
+};
+
+// Exported by every module built by c8emu-aot as `c8aot_manifest`
+struct AotManifest final
+{
+public:
+    u32             AbiVersion{};
+    u32             CPUDataSize{};
+    u32             RAMSize{};
+    const Byte*     Image{};     // ROM the module was built from
+    u32             ImageSize{};
+    const AotBlock* Blocks{};
+    u32             NumBlocks{};
+    void          (*Bind)(const ExecProc* executors) noexcept{};
+};
+
+// Instructions depending on state that lives in the emulator itself (the
+// random generator, the call stack, logging). Modules call back into the
+// host executors for these.
+[[nodiscard]] constexpr bool RunsOnHost(Instr instr) noexcept
+{
+    return instr == Instr::RAW || instr == Instr::CALL_ADDR || instr == Instr::RET || instr == Instr::RND_VX_BYTE;
+}
+
+// A statically recompiled ROM loaded from a shared object. Blocks are dropped
+// as soon as the program overwrites any of their bytes, the interpreter takes
+// over from there.
+class AotModule final
+{
+public:
+    constexpr AotModule() noexcept = default;
+    AotModule(const AotModule&) = delete;
+    AotModule(AotModule&&) = delete;
+    ~AotModule() noexcept;
+
+    [[nodiscard]] bool Load(const std::filesystem::path& filePath, const RAM& ram) noexcept;
+    void Unload() noexcept;
+
+    [[nodiscard]] constexpr const AotBlock* Lookup(Address pc) const noexcept { return m_Entries[static_cast<size_t>(pc & 0x0FFF)]; }
+    [[nodiscard]] constexpr bool IsLoaded() const noexcept { return m_Manifest != nullptr; }
+
+    void Invalidate(const RAM& ram, DirtyRange range) noexcept;
+
+private:
+    void Evict(size_t entry) noexcept;
+
+private:
+    using Entries = std::array<const AotBlock*, C8_MEMORY_SIZE>;
+    using ByteMap = std::array<u8, C8_MEMORY_SIZE>;
+
+    void*              m_Handle{};
+    const AotManifest* m_Manifest{};
+    Entries            m_Entries{};
+    ByteMap            m_CodeMap{}; // Number of blocks covering each byte
+};
+
+u32 RunAOT(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept;
+
+}
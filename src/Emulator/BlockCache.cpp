@@ -0,0 +1,76 @@
+#include "BlockCache.hpp"
+#include "Executors.hpp"
+#include "Fusion.hpp"
+#include "Timing.hpp"
+
+namespace c8emu {
+
+void DecodeBlock(const RAM& ram, Address entry, Block& block, size_t limit) noexcept
+{
+    block.Fused = nullptr;
+    block.Cycles = 0;
+    block.Entry = entry;
+    block.Length = 0;
+    block.Lookahead = 0;
+
+    Address pc = entry;
+    while (block.Length < C8_MAX_BLOCK_LENGTH)
+    {
+        const u16 raw = (static_cast<u16>(ram[pc]) << 8) | static_cast<u16>(ram[pc + 1]);
+        const OpCode op = Decode(raw);
+
+        block.Ops[block.Length++] = { SelectExecutor(op), op };
+        block.Cycles += GetVIPCycles(op);
+        pc += 2;
+
+        // Stop at the limit rather than wrapping around
+        if (EndsBlock(op.instr) || pc >= limit - 1)
+            break;
+    }
+}
+
+void BlockCache::Invalidate(DirtyRange range) noexcept
+{
+    for (Address addr = range.Begin; addr < range.End; addr++)
+    {
+        if (m_CodeMap[static_cast<size_t>(addr & 0x0FFF)] == 0)
+            continue;
+
+        for (size_t idx{}; idx < C8_BLOCK_CACHE_SIZE; idx++)
+        {
+            const Block& block = m_Blocks[idx];
+            if (block.Length > 0 && block.Covers(addr))
+                Evict(static_cast<u16>(idx));
+        }
+    }
+}
+
+const Block& BlockCache::Translate(const RAM& ram, Address entry) noexcept
+{
+    if (m_NumFree == 0)
+        Clear();
+
+    const u16 idx = m_Free[--m_NumFree];
+    Block& block = m_Blocks[idx];
+    DecodeBlock(ram, entry, block);
+    FuseBlock(ram, block);
+
+    for (size_t i{}; i < 2 * static_cast<size_t>(block.GetSpan()); i++)
+        m_CodeMap[(entry + i) & 0x0FFF]++;
+
+    m_Lookup[static_cast<size_t>(entry)] = idx;
+    return block;
+}
+
+void BlockCache::Evict(u16 idx) noexcept
+{
+    Block& block = m_Blocks[idx];
+    for (size_t i{}; i < 2 * static_cast<size_t>(block.GetSpan()); i++)
+        m_CodeMap[(block.Entry + i) & 0x0FFF]--;
+
+    m_Lookup[static_cast<size_t>(block.Entry)] = NO_BLOCK;
+    m_Free[m_NumFree++] = idx;
+    block.Length = 0;
+}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Instructions.hpp"
+#include "RAM.hpp"
+#include "Spec.hpp"
+
+#include <array>
+
+namespace c8emu {
+
+struct TranslatedOp final
+{
+public:
+    ExecProc proc{};
+    OpCode   op{};
+};
+
+// Runs the last two instructions of a block as one superinstruction and
+// returns how many instructions it retired, which may include one past the
+// end of the block (see Block::Lookahead)
+using FusedProc = u32(*)(CPUData&, RAM&, const OpCode&, const OpCode&) noexcept;
+
+// A straight-line run of instructions starting at `Entry`. Only the last
+// instruction may branch, skip or write to memory.
+struct Block final
+{
+public:
+    std::array<TranslatedOp, C8_MAX_BLOCK_LENGTH> Ops{};
+    FusedProc                                     Fused{};
+    u32                                           Cycles{}; // Cost on the COSMAC VIP, see GetVIPCycles
+    Address                                       Entry{};
+    u8                                            Length{};
+    u8                                            Lookahead{}; // Instructions read past the end by `Fused`
+
+public:
+    // Number of instructions the block depends on
+    [[nodiscard]] constexpr u8 GetSpan() const noexcept { return static_cast<u8>(Length + Lookahead); }
+
+    [[nodiscard]] constexpr bool Covers(Address addr) const noexcept
+    {
+        return static_cast<size_t>((addr - Entry) & 0x0FFF) < 2 * static_cast<size_t>(GetSpan());
+    }
+};
+
+// Decodes the block starting at `entry`, never reading past `limit`
+void DecodeBlock(const RAM& ram, Address entry, Block& block, size_t limit = C8_MEMORY_SIZE) noexcept;
+
+class BlockCache final
+{
+public:
+    constexpr BlockCache() noexcept { Clear(); }
+
+    [[nodiscard]] inline const Block& Lookup(const RAM& ram, Address pc) noexcept
+    {
+        const u16 idx = m_Lookup[static_cast<size_t>(pc & 0x0FFF)];
+        if (idx != NO_BLOCK)
+            return m_Blocks[idx];
+
+        return Translate(ram, pc & 0x0FFF);
+    }
+
+    void Invalidate(DirtyRange range) noexcept;
+    constexpr void Clear() noexcept
+    {
+        m_Lookup.fill(NO_BLOCK);
+        m_CodeMap.fill(0);
+
+        for (size_t i{}; i < C8_BLOCK_CACHE_SIZE; i++)
+        {
+            m_Blocks[i].Length = 0;
+            m_Free[i] = static_cast<u16>(C8_BLOCK_CACHE_SIZE - i - 1);
+        }
+
+        m_NumFree = C8_BLOCK_CACHE_SIZE;
+    }
+
+    [[nodiscard]] constexpr size_t GetNumBlocks() const noexcept { return C8_BLOCK_CACHE_SIZE - m_NumFree; }
+
+private:
+    [[nodiscard]] const Block& Translate(const RAM& ram, Address entry) noexcept;
+    void Evict(u16 idx) noexcept;
+
+private:
+    static constexpr u16 NO_BLOCK = 0xFFFF;
+
+    std::array<Block, C8_BLOCK_CACHE_SIZE> m_Blocks{};
+    std::array<u16, C8_BLOCK_CACHE_SIZE>   m_Free{};
+    std::array<u16, C8_MEMORY_SIZE>        m_Lookup{};
+    std::array<u8, C8_MEMORY_SIZE>         m_CodeMap{}; // Number of blocks covering each byte
+    size_t                                 m_NumFree{};
+};
+
+}
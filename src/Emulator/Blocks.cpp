@@ -0,0 +1,42 @@
+#include "Blocks.hpp"
+#include "Timing.hpp"
+
+namespace c8emu {
+
+u32 RunBlocks(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept
+{
+    u32 retired{};
+    while (retired < count && cpu.Wait != KeyWait::WAITING)
+    {
+        code.Sync(ram);
+
+        const Block& block = code.Blocks.Lookup(ram, cpu.PC);
+        retired += ExecuteBlock(cpu, ram, block, count - retired);
+    }
+
+    return retired;
+}
+
+u32 RunBlocksTimed(CPUData& cpu, RAM& ram, CodeCache& code, i32& cycles) noexcept
+{
+    u32 retired{};
+
+    // An Fx0A that starts waiting suspends the CPU until the next key event
+    while (cycles > 0 && cpu.Wait != KeyWait::WAITING)
+    {
+        code.Sync(ram);
+
+        // Capping the count at the block keeps a fused tail from running an
+        // instruction the block wasn't charged for
+        const Block& block = code.Blocks.Lookup(ram, cpu.PC);
+        cycles -= static_cast<i32>(block.Cycles);
+        retired += ExecuteBlock(cpu, ram, block, block.Length);
+
+        if (WaitsForDisplay(block.Ops[block.Length - 1].op.instr))
+            cycles = std::min(cycles, 0);
+    }
+
+    return retired;
+}
+
+}
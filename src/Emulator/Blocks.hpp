@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CPU.hpp"
+#include "CodeCache.hpp"
+#include "RAM.hpp"
+
+#include <algorithm>
+
+namespace c8emu {
+
+// Runs at most `count` instructions of `block` and returns how many were run
+[[nodiscard]] inline u32 ExecuteBlock(CPUData& cpu, RAM& ram, const Block& block, u32 count) noexcept
+{
+    const u32 length = std::min(static_cast<u32>(block.Length), count);
+    const Address pc = cpu.PC;
+
+    // The fused tail is all or nothing, so it only runs when the budget
+    // covers everything it could retire. Otherwise the block runs one
+    // instruction at a time and stops exactly where the budget runs out.
+    const bool fused = block.Fused && count >= static_cast<u32>(block.GetSpan());
+    const u32 plain = fused ? length - 2 : length - 1;
+
+    // Only the last instruction of a block can observe the program counter,
+    // so it is advanced once for the whole run. Running a prefix is fine as
+    // well, since that never includes the terminator.
+    for (u32 i{}; i < plain; i++)
+        block.Ops[i].proc(cpu, ram, block.Ops[i].op);
+
+    cpu.PC = pc + 2 * length;
+    if (fused)
+        return plain + block.Fused(cpu, ram, block.Ops[length - 2].op, block.Ops[length - 1].op);
+
+    block.Ops[length - 1].proc(cpu, ram, block.Ops[length - 1].op);
+    return length;
+}
+
+u32 RunBlocks(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept;
+
+// Runs whole blocks for as long as any of `cycles` is left, charging each one
+// its VIP cost up front. The budget is only checked between blocks and may
+// end up negative, which the caller carries over into the next frame.
+// Returns the number of instructions run.
+u32 RunBlocksTimed(CPUData& cpu, RAM& ram, CodeCache& code, i32& cycles) noexcept;
+
+}
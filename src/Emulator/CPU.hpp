@@ -2,8 +2,12 @@
 
 #include "Spec.hpp"
 #include "CallStack.hpp"
+#include "Engine.hpp"
+#include "Timing.hpp"
 
 #include <array>
+#include <filesystem>
+#include <memory>
 
 namespace c8emu {
 
@@ -45,10 +49,53 @@ private:
     RegisterBuffer m_Registers{};
 };
 
+enum class FlagOp : u8
+{
+    NONE,
+    ZERO,
+    CARRY,
+    NO_BORROW,
+    LSB,
+    MSB,
+};
+
+// The VF result of the last arithmetic instruction, kept as its operands
+// until something actually reads VF
+struct PendingFlag final
+{
+public:
+    FlagOp Op{};
+    u8     A{};
+    u8     B{};
+};
+
+// Progress of an Fx0A instruction. It waits for a key to be pressed and then
+// released, as on the COSMAC VIP, with CPU::SetKey driving the transitions.
+enum class KeyWait : u8
+{
+    NONE,
+    WAITING,
+    PRESSED,
+    RELEASED,
+};
+
+// One bit per pixel and one word per row, with the leftmost pixel in the
+// most significant bit
+using VideoRow = u64;
+
+constexpr size_t C8_VIDEO_ROW_BITS = sizeof(VideoRow) * 8;
+
+static_assert(C8_SCREEN_BUFFER_WIDTH<size_t> == C8_VIDEO_ROW_BITS, "DRW clips at the right edge by shifting out of the row");
+
+// One bit per display row, set by CLS and DRW whenever they change that row
+using DirtyRows = u32;
+
+static_assert(C8_SCREEN_BUFFER_HEIGHT<size_t> <= sizeof(DirtyRows) * 8, "Every row needs its own dirty bit");
+
 struct CPUData final
 {
 public:
-    using VideoBuffer = std::array<Byte, C8_SCREEN_BUFFER_WIDTH<size_t> * C8_SCREEN_BUFFER_HEIGHT<size_t>>;
+    using VideoBuffer = std::array<VideoRow, C8_SCREEN_BUFFER_HEIGHT<size_t>>;
     using KeyPad      = std::array<u8, C8_NUM_KEYS>;
 
 public:
@@ -60,20 +107,86 @@ public:
     u16         PC{C8_ADDR_PC};
     u8          DT{};
     u8          ST{};
+    PendingFlag Flag{};
+    KeyWait     Wait{};
+    u8          WaitKey{};
+    DirtyRows   Dirty{}; // Rows changed since the frontend last cleared them
+};
+
+[[nodiscard]] constexpr bool IsPixelLit(const CPUData::VideoBuffer& video, size_t x, size_t y) noexcept
+{
+    return (video[y] >> (C8_VIDEO_ROW_BITS - 1 - x)) & 0x01;
+}
+
+constexpr void MaterializeFlag(CPUData& cpu) noexcept
+{
+    const PendingFlag flag = cpu.Flag;
+    if (flag.Op == FlagOp::NONE)
+        return;
+
+    u8& vf = cpu.Registers[RegisterID::VF];
+    switch (flag.Op)
+    {
+        case FlagOp::ZERO:      vf = 0; break;
+        case FlagOp::CARRY:     vf = static_cast<u16>(flag.A) + static_cast<u16>(flag.B) > 0x00FF; break;
+        case FlagOp::NO_BORROW: vf = flag.A >= flag.B; break;
+        case FlagOp::LSB:       vf = flag.A & 0x01; break;
+        case FlagOp::MSB:       vf = flag.A >> 7; break;
+        default:                break;
+    }
+
+    cpu.Flag.Op = FlagOp::NONE;
+}
+
+struct ExecStats final
+{
+public:
+    u64 Retired{}; // Every instruction the program has run, skipped or not
+    u64 Skipped{}; // Instructions skipped over in idle loops
 };
 
 class CPU
 {
 public:
-    constexpr CPU() noexcept = default;
+    CPU() noexcept;
     
     void Step(RAM& ram) noexcept;
     void SetKey(u8 key, u8 val) noexcept;
 
+    // No instructions run while an Fx0A waits for its key, only the timers
+    [[nodiscard]] constexpr bool IsWaitingForKey() const noexcept
+    {
+        return m_Data.Wait == KeyWait::WAITING || m_Data.Wait == KeyWait::PRESSED;
+    }
+
+    void SetEngine(EngineID engine) noexcept;
+    EngineID Calibrate(const RAM& ram) noexcept;
+
+    // The instruction rate only applies to the fixed timing model. The VIP
+    // model always runs through translated blocks, whichever engine is set.
+    constexpr void SetTiming(TimingModel timing) noexcept { m_Timing = timing; m_Cycles = 0; }
+    constexpr void SetInstructionsPerFrame(u32 count) noexcept { m_InstructionsPerFrame = count > 0 ? count : 1; }
+
+    constexpr void SetTierThresholds(TierThresholds thresholds) noexcept { m_Context.Tiers.SetThresholds(thresholds); }
+    [[nodiscard]] inline bool LoadAOT(const std::filesystem::path& filePath, const RAM& ram) noexcept { return m_Context.Code.Static.Load(filePath, ram); }
+
+    constexpr void ClearDirtyRows() noexcept { m_Data.Dirty = 0; }
+
     [[nodiscard]] inline const CPUData& GetData() const noexcept { return m_Data; }
+    [[nodiscard]] inline EngineID GetEngine() const noexcept { return m_Engine->GetID(); }
+    [[nodiscard]] constexpr const TierStats& GetTierStats() const noexcept { return m_Context.Tiers.GetStats(); }
+    [[nodiscard]] constexpr const ExecStats& GetExecStats() const noexcept { return m_Stats; }
+    [[nodiscard]] constexpr TimingModel GetTiming() const noexcept { return m_Timing; }
+    [[nodiscard]] constexpr u32 GetInstructionsPerFrame() const noexcept { return m_InstructionsPerFrame; }
 
 private:
-    CPUData m_Data{};
+    CPUData                          m_Data{};
+    ExecStats                        m_Stats{};
+    TimingModel                      m_Timing{TimingModel::FIXED};
+    u32                              m_InstructionsPerFrame{C8_OPS_PER_CYCLE};
+    i32                              m_Cycles{}; // VIP cycles left over from the previous frame
+    EngineContext                    m_Context{};
+    std::unique_ptr<ExecutionEngine> m_Engine{};
 };
 
 }
@@ -1,9 +1,10 @@
 #include "Chip8.hpp"
-#include "Keyboard.hpp"
 
 #include "Core/Debug.hpp"
+#include "Core/Thread.hpp"
 
-#include "Renderer/Renderer.hpp"
+#include <chrono>
+#include <cmath>
 
 namespace c8emu {
 
@@ -21,101 +22,187 @@ bool Chip8::LoadROM(const std::filesystem::path& filePath) noexcept
     return true;
 }
 
-void Chip8::OnEvent(const sf::Event& event) noexcept
+bool Chip8::LoadAOT(const std::filesystem::path& filePath) noexcept
 {
-    if (const auto keyPress = event.getIf<sf::Event::KeyPressed>())
+    // The module is checked against the ROM, so that has to be loaded first
+    if (!m_ROMLoaded)
     {
-        for (u8 k{}; k < C8_NUM_KEYS; k++)
-            if (keyPress->code == C8_KEYS[k])
-                m_CPU.SetKey(k, 1);
+        C8_LOG_ERROR("Cannot load recompiled module without a ROM: {}", filePath.string());
+        return false;
     }
-    else if (const auto keyRelease = event.getIf<sf::Event::KeyReleased>())
+
+    return m_CPU.LoadAOT(filePath, m_RAM);
+}
+
+void Chip8::CalibrateEngine() noexcept
+{
+    // Calibrating on an empty machine would only measure the bootstrap
+    if (!m_ROMLoaded)
     {
-        for (u8 k{}; k < C8_NUM_KEYS; k++)
-            if (keyRelease->code == C8_KEYS[k])
-                m_CPU.SetKey(k, 0);
+        C8_LOG_WARNING("Cannot calibrate engines without a ROM");
+        return;
     }
+
+    (void)m_CPU.Calibrate(m_RAM);
+}
+
+void Chip8::Start(std::optional<u32> core) noexcept
+{
+    if (!m_ROMLoaded)
+        return;
+
+    Publish();
+    m_Thread = std::jthread([this](std::stop_token stop) { Run(stop); });
+
+    if (core && !PinThread(m_Thread, *core))
+        C8_LOG_WARNING("Failed to pin the emulation thread to core {}", *core);
 }
 
-void Chip8::OnUpdate(float dt) noexcept
+void Chip8::Stop() noexcept
 {
-    if (m_Tick >= C8_TICK_RATE)
+    if (!m_Thread.joinable())
+        return;
+
+    m_Thread.request_stop();
+    m_Thread.join();
+}
+
+void Chip8::OnKey(u8 key, bool pressed) noexcept
+{
+    if (!IsValidKey(key))
+        return;
+
+    if (!m_KeyEvents.Push({ key, static_cast<u8>(pressed) }))
+        C8_LOG_WARNING("Dropped key event, the emulation thread is falling behind");
+}
+
+void Chip8::OnUpdate() noexcept
+{
+    if (!m_Snapshots.Consume())
+        m_Snapshots.GetFrontBuffer().CPU.Dirty = 0;
+}
+
+void Chip8::Run(std::stop_token stop) noexcept
+{
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point last = Clock::now();
+    while (!stop.stop_requested())
     {
-        if (m_ROMLoaded)
-            m_CPU.Step(m_RAM);
+        while (const std::optional<KeyEvent> event = m_KeyEvents.Pop())
+            m_CPU.SetKey(event->Key, event->Value);
 
-        m_Tick -= C8_TICK_RATE;
+        const Clock::time_point now = Clock::now();
+        Update(std::chrono::duration<float>(now - last).count());
+        last = now;
+
+        Publish();
+
+        // Sleeping until the next frame is due leaves the thread idle while
+        // the program waits for a key, as nothing else can happen meanwhile.
+        // The deadline stays in the clock's integer ticks, a float time point
+        // loses precision as the host's uptime grows.
+        if (!m_Turbo && !m_TurboHeld.load(std::memory_order_relaxed))
+        {
+            const std::chrono::duration<float> remaining(C8_TICK_RATE - m_Tick);
+            std::this_thread::sleep_until(now + std::chrono::duration_cast<Clock::duration>(remaining));
+        }
     }
+}
 
+void Chip8::Update(float dt) noexcept
+{
+    UpdateStats(dt);
+    if (!m_ROMLoaded)
+        return;
+
+    if (m_Turbo || m_TurboHeld.load(std::memory_order_relaxed))
+    {
+        RunTurbo();
+        m_Tick = 0.0f;
+        return;
+    }
+
+    // Every frame that is due gets run, up to a limit. Whatever is still
+    // owed after a hitch is dropped instead of leaving the emulation behind
+    // for good.
     m_Tick += dt;
+    for (u32 i{}; i < C8_MAX_CATCH_UP_FRAMES && m_Tick >= C8_TICK_RATE; i++)
+    {
+        RunFrame();
+        m_Tick -= C8_TICK_RATE;
+    }
+
+    m_Tick = std::fmod(m_Tick, C8_TICK_RATE);
 }
 
-void Chip8::OnRender(RenderContext& ctx) const noexcept
+void Chip8::RunFrame() noexcept
 {
-    const CPUData& cpuData = m_CPU.GetData();
-    ctx.DrawBuffer(cpuData.Video.data(), C8_SCREEN_BUFFER_WIDTH<size_t>, C8_SCREEN_BUFFER_HEIGHT<size_t>);
+    m_CPU.Step(m_RAM);
+    m_Frames++;
+}
 
-    if (ctx.DebugOverlayEnabled())
+void Chip8::RunTurbo() noexcept
+{
+    if (m_TurboFrames > 0)
     {
-        ctx.AddDebugText("CPU:");
-        ctx.AddDebugText(" REGISTERS:");
-        ctx.AddDebugText("  V0:{} V1:{} V2:{} V3:{}",
-            cpuData.Registers[RegisterID::V0],
-            cpuData.Registers[RegisterID::V1],
-            cpuData.Registers[RegisterID::V2],
-            cpuData.Registers[RegisterID::V3]
-        );
-        ctx.AddDebugText("  V4:{} V5:{} V6:{} V7:{}",
-            cpuData.Registers[RegisterID::V4],
-            cpuData.Registers[RegisterID::V5],
-            cpuData.Registers[RegisterID::V6],
-            cpuData.Registers[RegisterID::V7]
-        );
-        ctx.AddDebugText("  V8:{} V9:{} VA:{} VB:{}",
-            cpuData.Registers[RegisterID::V8],
-            cpuData.Registers[RegisterID::V9],
-            cpuData.Registers[RegisterID::VA],
-            cpuData.Registers[RegisterID::VB]
-        );
-        ctx.AddDebugText("  VC:{} VD:{} VE:{} VF:{}",
-            cpuData.Registers[RegisterID::VC],
-            cpuData.Registers[RegisterID::VD],
-            cpuData.Registers[RegisterID::VE],
-            cpuData.Registers[RegisterID::VF]
-        );
-
-        ctx.AddDebugText(" INDEX REGISTER: {}", cpuData.Idx);
-        ctx.AddDebugText(" PROGRAM COUNTER: {}", cpuData.PC);
-
-        ctx.AddDebugText(" DELAY TIMER: {}", cpuData.DT);
-        ctx.AddDebugText(" SOUND TIMER: {}", cpuData.ST);
-
-        ctx.AddDebugText(" KEYPAD:");
-        ctx.AddDebugText("  K1:{} K2:{} K3:{} KC:{}",
-            cpuData.Keypad[0x1],
-            cpuData.Keypad[0x2],
-            cpuData.Keypad[0x3],
-            cpuData.Keypad[0xC]
-        );
-        ctx.AddDebugText("  K4:{} K5:{} K6:{} KD:{}",
-            cpuData.Keypad[0x4],
-            cpuData.Keypad[0x5],
-            cpuData.Keypad[0x6],
-            cpuData.Keypad[0xD]
-        );
-        ctx.AddDebugText("  K7:{} K8:{} K9:{} KE:{}",
-            cpuData.Keypad[0x7],
-            cpuData.Keypad[0x8],
-            cpuData.Keypad[0x9],
-            cpuData.Keypad[0xE]
-        );
-        ctx.AddDebugText("  KA:{} K0:{} KB:{} KF:{}",
-            cpuData.Keypad[0xA],
-            cpuData.Keypad[0x0],
-            cpuData.Keypad[0xB],
-            cpuData.Keypad[0xF]
-        );
+        for (u32 i{}; i < m_TurboFrames; i++)
+            RunFrame();
+
+        return;
     }
+
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point t0 = Clock::now();
+    const std::chrono::duration<float> budget(C8_TURBO_TIME_BUDGET);
+    do
+    {
+        RunFrame();
+    } while (Clock::now() - t0 < budget);
+}
+
+void Chip8::UpdateStats(float dt) noexcept
+{
+    m_StatsTick += dt;
+    if (m_StatsTick < STATS_INTERVAL)
+        return;
+
+    // Skipped instructions count as retired, the program did run them after
+    // all, just not on the host
+    const ExecStats& stats = m_CPU.GetExecStats();
+    const u64 retired = stats.Retired - m_LastStats.Retired;
+    const u64 skipped = stats.Skipped - m_LastStats.Skipped;
+
+    m_IPS = static_cast<float>(retired) / m_StatsTick;
+    m_IdleShare = retired > 0 ? 100.0f * static_cast<float>(skipped) / static_cast<float>(retired) : 0.0f;
+
+    m_Speed = static_cast<float>(m_Frames - m_LastFrames) * C8_TICK_RATE / m_StatsTick;
+
+    m_LastStats = stats;
+    m_LastFrames = m_Frames;
+    m_StatsTick = 0.0f;
+}
+
+void Chip8::Publish() noexcept
+{
+    FrameSnapshot& frame = m_Snapshots.GetBackBuffer();
+    frame.CPU = m_CPU.GetData();
+    frame.CPU.Dirty |= m_Unseen;
+    m_CPU.ClearDirtyRows();
+    frame.Tiers = m_CPU.GetTierStats();
+    frame.Engine = m_CPU.GetEngine();
+    frame.Timing = m_CPU.GetTiming();
+    frame.InstructionsPerFrame = m_CPU.GetInstructionsPerFrame();
+    frame.IPS = m_IPS;
+    frame.IdleShare = m_IdleShare;
+    frame.Speed = m_Speed;
+    frame.WaitingForKey = m_CPU.IsWaitingForKey();
+    frame.Turbo = m_Turbo || m_TurboHeld.load(std::memory_order_relaxed);
+
+    // A snapshot that gets overwritten before the UI sees it hands its
+    // changes on to the next one
+    m_Unseen = m_Snapshots.Publish() ? m_Snapshots.GetBackBuffer().CPU.Dirty : 0;
 }
 
 }
@@ -1,36 +1,108 @@
 #pragma once
 
 #include "CPU.hpp"
+#include "Input.hpp"
 #include "RAM.hpp"
 #include "ROM.hpp"
 
-#include <SFML/Window/Event.hpp>
+#include "Core/SPSCQueue.hpp"
+#include "Core/TripleBuffer.hpp"
 
+#include <atomic>
 #include <filesystem>
+#include <optional>
+#include <thread>
 
 namespace c8emu {
 
-class RenderContext;
+// Everything the UI shows about the machine, copied out of the emulation
+// thread once per update. CPU.Dirty holds the rows changed since the UI last
+// picked up a snapshot.
+struct FrameSnapshot final
+{
+public:
+    CPUData     CPU{};
+    TierStats   Tiers{};
+    EngineID    Engine{};
+    TimingModel Timing{};
+    u32         InstructionsPerFrame{};
+    float       IPS{};
+    float       IdleShare{};
+    float       Speed{};
+    bool        WaitingForKey{};
+    bool        Turbo{};
+};
 
+// The machine runs on a thread of its own once started, paced by the host's
+// clock. Everything before Start() configures it from the calling thread.
 class Chip8 final
 {
 public:
-    constexpr Chip8() noexcept = default;
+    Chip8() noexcept = default;
+    ~Chip8() noexcept { Stop(); }
     
     [[nodiscard]] bool LoadROM(const std::filesystem::path& filePath) noexcept;
+    [[nodiscard]] bool LoadAOT(const std::filesystem::path& filePath) noexcept;
+
+    inline void SetEngine(EngineID engine) noexcept { m_CPU.SetEngine(engine); }
+    void CalibrateEngine() noexcept;
+    constexpr void SetTierThresholds(TierThresholds thresholds) noexcept { m_CPU.SetTierThresholds(thresholds); }
+    constexpr void SetTiming(TimingModel timing) noexcept { m_CPU.SetTiming(timing); }
+    constexpr void SetInstructionsPerFrame(u32 count) noexcept { m_CPU.SetInstructionsPerFrame(count); }
+
+    // Turbo mode runs `frames` emulated frames per update, or as many as fit
+    // in C8_TURBO_TIME_BUDGET if that is zero
+    constexpr void SetTurbo(bool enabled) noexcept { m_Turbo = enabled; }
+    constexpr void SetTurboFrames(u32 frames) noexcept { m_TurboFrames = frames; }
+
+    // Optionally pins the emulation thread to the given core
+    void Start(std::optional<u32> core = std::nullopt) noexcept;
+    void Stop() noexcept;
 
-    void OnEvent(const sf::Event& event) noexcept;
-    void OnUpdate(float dt) noexcept;
-    void OnRender(RenderContext& ctx) const noexcept;
+    // UI thread
+    void OnKey(u8 key, bool pressed) noexcept;
+    inline void SetTurboHeld(bool held) noexcept { m_TurboHeld.store(held, std::memory_order_relaxed); }
+    void OnUpdate() noexcept;
+
+    // The latest state published by the emulation thread, valid until the
+    // next OnUpdate(). Its dirty rows are cleared when no newer snapshot came
+    // in, so the same changes are never reported twice.
+    [[nodiscard]] inline const FrameSnapshot& GetSnapshot() const noexcept { return m_Snapshots.GetFrontBuffer(); }
 
     [[nodiscard]] inline const ROM& GetROM() const noexcept { return m_ROM; }
 
 private:
-    RAM   m_RAM{};
-    CPU   m_CPU{};
-    ROM   m_ROM{};
-    float m_Tick{};
-    bool  m_ROMLoaded{};
+    // Emulation thread
+    void Run(std::stop_token stop) noexcept;
+    void Update(float dt) noexcept;
+    void RunFrame() noexcept;
+    void RunTurbo() noexcept;
+    void UpdateStats(float dt) noexcept;
+    void Publish() noexcept;
+
+private:
+    static constexpr float STATS_INTERVAL = 1.0f; // Seconds between refreshes of the measured rates
+
+    RAM       m_RAM{};
+    CPU       m_CPU{};
+    ROM       m_ROM{};
+    ExecStats m_LastStats{};
+    DirtyRows m_Unseen{}; // Changes of snapshots the UI never picked up
+    u64       m_Frames{};
+    u64       m_LastFrames{};
+    u32       m_TurboFrames{};
+    float     m_Tick{};
+    float     m_StatsTick{};
+    float     m_IPS{};
+    float     m_IdleShare{};
+    float     m_Speed{};
+    bool      m_ROMLoaded{};
+    bool      m_Turbo{};
+
+    TripleBuffer<FrameSnapshot> m_Snapshots{};
+    SPSCQueue<KeyEvent, 64>     m_KeyEvents{};
+    std::atomic<bool>           m_TurboHeld{};
+    std::jthread                m_Thread{}; // Last, so that it is joined before anything it uses goes away
 };
 
 }
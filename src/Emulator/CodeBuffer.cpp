@@ -0,0 +1,53 @@
+#include "CodeBuffer.hpp"
+#include "Spec.hpp"
+
+#include "Core/Debug.hpp"
+
+#if defined(C8_JIT)
+
+#include <sys/mman.h>
+
+namespace c8emu {
+
+CodeBuffer::~CodeBuffer() noexcept
+{
+    if (m_Ptr)
+        munmap(m_Ptr, m_Size);
+}
+
+void CodeBuffer::BeginWrite() noexcept
+{
+    if (!m_Ptr)
+    {
+        void* ptr = mmap(nullptr, C8_JIT_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            Panic(ErrorCode::OUT_OF_MEMORY, "Failed to map {} bytes for the JIT", C8_JIT_BUFFER_SIZE);
+
+        m_Ptr = static_cast<u8*>(ptr);
+        m_Size = C8_JIT_BUFFER_SIZE;
+        return;
+    }
+
+    Protect(PROT_READ | PROT_WRITE);
+}
+
+void CodeBuffer::EndWrite(size_t used) noexcept
+{
+    m_Used += used;
+    Protect(PROT_READ | PROT_EXEC);
+}
+
+void CodeBuffer::Reset() noexcept
+{
+    m_Used = 0;
+}
+
+void CodeBuffer::Protect(int prot) noexcept
+{
+    if (mprotect(m_Ptr, m_Size, prot) != 0)
+        Panic(ErrorCode::FAILED_TO_PROTECT_CODE, "Failed to change protection of JIT buffer");
+}
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Core/Types.hpp"
+
+namespace c8emu {
+
+// Executable memory for the JIT. The buffer is never writable and executable
+// at the same time: it is flipped to read/write while a block is emitted and
+// back to read/execute before anything runs from it.
+class CodeBuffer final
+{
+public:
+    constexpr CodeBuffer() noexcept = default;
+    CodeBuffer(const CodeBuffer&) = delete;
+    CodeBuffer(CodeBuffer&&) = delete;
+    ~CodeBuffer() noexcept;
+
+    void BeginWrite() noexcept;
+    void EndWrite(size_t used) noexcept;
+    void Reset() noexcept;
+
+    [[nodiscard]] constexpr u8* GetCursor() noexcept { return m_Ptr + m_Used; }
+    [[nodiscard]] constexpr size_t GetRemaining() const noexcept { return m_Size - m_Used; }
+    [[nodiscard]] constexpr size_t GetUsed() const noexcept { return m_Used; }
+
+private:
+    void Protect(int prot) noexcept;
+
+private:
+    u8*    m_Ptr{};
+    size_t m_Size{};
+    size_t m_Used{};
+};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "AOT.hpp"
+#include "BlockCache.hpp"
+#include "DecodeCache.hpp"
+#include "JIT.hpp"
+#include "RAM.hpp"
+
+namespace c8emu {
+
+// Every structure holding translated code. They are all invalidated together
+// so that switching engines never runs stale code.
+struct CodeCache final
+{
+public:
+    DecodeCache Decoded{};
+    BlockCache  Blocks{};
+    AotModule   Static{};
+#if defined(C8_JIT)
+    JitCache    Native{};
+#endif
+
+public:
+    // Returns the range that was invalidated, if any
+    inline DirtyRange Sync(RAM& ram) noexcept
+    {
+        if (!ram.IsDirty())
+            return {};
+
+        const DirtyRange range = ram.TakeDirtyRange();
+        Decoded.Invalidate(range);
+        Blocks.Invalidate(range);
+        Static.Invalidate(ram, range);
+#if defined(C8_JIT)
+        Native.Invalidate(range);
+#endif
+        return range;
+    }
+};
+
+}
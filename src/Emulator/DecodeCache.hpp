@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Instructions.hpp"
+#include "RAM.hpp"
+#include "Spec.hpp"
+
+#include <array>
+
+namespace c8emu {
+
+class DecodeCache final
+{
+public:
+    constexpr DecodeCache() noexcept = default;
+
+    // Memory is only read on a miss, a hit touches nothing but the cache
+    [[nodiscard]] inline const OpCode& Fetch(const RAM& ram, Address pc) noexcept
+    {
+        // Instructions are only cached on even addresses, anything else is
+        // decoded on the fly
+        if (pc & 0x0001)
+        {
+            m_Unaligned = Decode(ReadRaw(ram, pc));
+            return m_Unaligned;
+        }
+
+        const size_t slot = static_cast<size_t>((pc & 0x0FFF) >> 1);
+        if (!m_Valid[slot])
+        {
+            m_Slots[slot] = Decode(ReadRaw(ram, pc));
+            m_Valid[slot] = true;
+        }
+
+        return m_Slots[slot];
+    }
+
+    constexpr void Invalidate(DirtyRange range) noexcept
+    {
+        if (range.IsEmpty())
+            return;
+
+        const size_t first = static_cast<size_t>(range.Begin >> 1);
+        const size_t last = static_cast<size_t>((range.End - 1) >> 1);
+        for (size_t slot = first; slot <= last && slot < NUM_SLOTS; slot++)
+            m_Valid[slot] = false;
+    }
+
+    constexpr void Clear() noexcept
+    {
+        m_Valid.fill(false);
+    }
+
+private:
+    [[nodiscard]] static inline u16 ReadRaw(const RAM& ram, Address pc) noexcept
+    {
+        return (static_cast<u16>(ram[pc]) << 8) | static_cast<u16>(ram[pc + 1]);
+    }
+
+private:
+    static constexpr size_t NUM_SLOTS = C8_MEMORY_SIZE / 2;
+
+    std::array<OpCode, NUM_SLOTS> m_Slots{};
+    std::array<bool, NUM_SLOTS>   m_Valid{};
+    OpCode                        m_Unaligned{};
+};
+
+}
@@ -0,0 +1,211 @@
+#include "Engine.hpp"
+#include "AOT.hpp"
+#include "Blocks.hpp"
+#include "CPU.hpp"
+#include "Executors.hpp"
+#include "Idle.hpp"
+#include "JIT.hpp"
+#include "Threaded.hpp"
+
+#include "Core/Debug.hpp"
+
+#include <chrono>
+
+namespace c8emu {
+
+// --- engines ----------------------------------------------------------------
+
+static u32 RunLoop(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept
+{
+    u32 retired{};
+    while (retired < count && cpu.Wait != KeyWait::WAITING)
+    {
+        code.Sync(ram);
+
+        const OpCode& opcode = code.Decoded.Fetch(ram, cpu.PC);
+        cpu.PC += 2;
+
+        SelectExecutor(opcode)(cpu, ram, opcode);
+        retired++;
+    }
+
+    return retired;
+}
+
+using RunProc = u32(*)(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept;
+
+// Every engine that only needs the code caches
+template<EngineID ID, RunProc Proc>
+class CachedEngine final : public ExecutionEngine
+{
+public:
+    explicit CachedEngine(CodeCache& code) noexcept :
+        m_Code(code) {}
+
+    u32 Run(CPUData& cpu, RAM& ram, u32 count) noexcept override { return Proc(cpu, ram, m_Code, count); }
+
+    [[nodiscard]] EngineID GetID() const noexcept override { return ID; }
+
+private:
+    CodeCache& m_Code;
+};
+
+class TieredEngine final : public ExecutionEngine
+{
+public:
+    explicit TieredEngine(EngineContext& ctx) noexcept :
+        m_Context(ctx) {}
+
+    u32 Run(CPUData& cpu, RAM& ram, u32 count) noexcept override { return RunTiered(cpu, ram, m_Context.Code, m_Context.Tiers, count); }
+
+    [[nodiscard]] EngineID GetID() const noexcept override { return EngineID::TIERED; }
+
+private:
+    EngineContext& m_Context;
+};
+
+template<EngineID ID, RunProc Proc>
+static std::unique_ptr<ExecutionEngine> CreateCached(EngineContext& ctx) noexcept
+{
+    return std::make_unique<CachedEngine<ID, Proc>>(ctx.Code);
+}
+
+static std::unique_ptr<ExecutionEngine> CreateTiered(EngineContext& ctx) noexcept
+{
+    return std::make_unique<TieredEngine>(ctx);
+}
+
+// --- registry ---------------------------------------------------------------
+
+#if defined(C8_JIT)
+constexpr bool JIT_AVAILABLE = true;
+constexpr RunProc JIT_PROC = RunJIT;
+#else
+constexpr bool JIT_AVAILABLE = false;
+constexpr RunProc JIT_PROC = RunBlocks;
+#endif
+
+// The AOT engine is left out of calibration, it is only useful with the
+// module given on the command line
+static constexpr EngineInfo s_Engines[] = {
+    { EngineID::LOOP,     "loop",     CreateCached<EngineID::LOOP, RunLoop>,         true          },
+    { EngineID::THREADED, "threaded", CreateCached<EngineID::THREADED, RunThreaded>, true          },
+    { EngineID::BLOCK,    "block",    CreateCached<EngineID::BLOCK, RunBlocks>,      true          },
+    { EngineID::JIT,      "jit",      CreateCached<EngineID::JIT, JIT_PROC>,         JIT_AVAILABLE },
+    { EngineID::AOT,      "aot",      CreateCached<EngineID::AOT, RunAOT>,           false         },
+    { EngineID::TIERED,   "tiered",   CreateTiered,                                  true          },
+};
+
+std::span<const EngineInfo> GetEngines() noexcept
+{
+    return s_Engines;
+}
+
+std::string_view GetEngineName(EngineID id) noexcept
+{
+    for (const EngineInfo& info : s_Engines)
+        if (info.ID == id)
+            return info.Name;
+
+    return "unknown";
+}
+
+std::optional<EngineID> ParseEngineID(std::string_view name) noexcept
+{
+    for (const EngineInfo& info : s_Engines)
+        if (info.Name == name)
+            return info.ID;
+
+    return std::nullopt;
+}
+
+std::unique_ptr<ExecutionEngine> CreateEngine(EngineID id, EngineContext& ctx) noexcept
+{
+    for (const EngineInfo& info : s_Engines)
+        if (info.ID == id)
+            return info.Create(ctx);
+
+    return CreateCached<EngineID::LOOP, RunLoop>(ctx);
+}
+
+// --- calibration ------------------------------------------------------------
+
+// Runs up to `frames` frames the same way CPU::Step does in the fixed timing
+// model and returns the number of instructions the engine actually ran. A
+// key wait ends the sample, since no key is ever pressed here and the machine
+// would stay idle for the rest of it.
+static u32 RunFrames(ExecutionEngine& engine, CPUData& cpu, RAM& ram, u32 instructionsPerFrame, u32 frames) noexcept
+{
+    u32 retired{};
+    for (u32 i{}; i < frames; i++)
+    {
+        if (cpu.Wait == KeyWait::WAITING || cpu.Wait == KeyWait::PRESSED)
+            break;
+
+        // Idle frames only tick the timers and aren't credited to the engine
+        if (SkipIdleLoop(cpu, ram, instructionsPerFrame) == 0)
+            retired += engine.Run(cpu, ram, instructionsPerFrame);
+
+        MaterializeFlag(cpu);
+
+        if (cpu.DT > 0)
+            cpu.DT--;
+
+        if (cpu.ST > 0)
+            cpu.ST--;
+    }
+
+    return retired;
+}
+
+EngineID CalibrateEngines(const CPUData& cpu, const RAM& ram, u32 instructionsPerFrame) noexcept
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Whole frames covering the instruction counts, so every engine is cut
+    // off at the same frame boundaries
+    const u32 warmupFrames = (C8_CALIBRATION_WARMUP + instructionsPerFrame - 1) / instructionsPerFrame;
+    const u32 timedFrames = (C8_CALIBRATION_INSTRUCTIONS + instructionsPerFrame - 1) / instructionsPerFrame;
+
+    EngineID best = EngineID::LOOP;
+    double bestRate{};
+
+    for (const EngineInfo& info : s_Engines)
+    {
+        if (!info.Calibrate)
+            continue;
+
+        // Each engine gets its own caches and copy of the machine, so nothing
+        // it does leaks into the real state
+        const auto ctx = std::make_unique<EngineContext>();
+        const auto engine = info.Create(*ctx);
+        auto scratchCPU = std::make_unique<CPUData>(cpu);
+        RAM scratchRAM = ram;
+
+        RunFrames(*engine, *scratchCPU, scratchRAM, instructionsPerFrame, warmupFrames);
+
+        const Clock::time_point t0 = Clock::now();
+        const u32 retired = RunFrames(*engine, *scratchCPU, scratchRAM, instructionsPerFrame, timedFrames);
+        const std::chrono::duration<double> elapsed = Clock::now() - t0;
+
+        if (retired == 0)
+        {
+            C8_LOG_INFO("Calibration: {} engine ran nothing before the machine went idle", info.Name);
+            continue;
+        }
+
+        const double rate = static_cast<double>(retired) / std::max(elapsed.count(), 1e-9);
+        C8_LOG_INFO("Calibration: {} engine runs {:.2f}M instructions per second", info.Name, rate / 1'000'000.0);
+
+        if (rate > bestRate)
+        {
+            best = info.ID;
+            bestRate = rate;
+        }
+    }
+
+    C8_LOG_INFO("Calibration picked the {} engine", GetEngineName(best));
+    return best;
+}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CodeCache.hpp"
+#include "RAM.hpp"
+#include "Tiering.hpp"
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace c8emu {
+
+// Forward decleration
+struct CPUData;
+
+enum class EngineID : u8
+{
+    LOOP,
+    THREADED,
+    BLOCK,
+    JIT,
+    AOT,
+    TIERED,
+};
+
+// State shared by every engine, kept outside of them so that switching
+// engines keeps the caches coherent with memory
+struct EngineContext final
+{
+public:
+    CodeCache   Code{};
+    TierManager Tiers{};
+};
+
+class ExecutionEngine
+{
+public:
+    virtual ~ExecutionEngine() noexcept = default;
+
+    // Runs up to `count` instructions, stopping early once an Fx0A starts
+    // waiting for a key. Returns the number of instructions run.
+    virtual u32 Run(CPUData& cpu, RAM& ram, u32 count) noexcept = 0;
+
+    [[nodiscard]] virtual EngineID GetID() const noexcept = 0;
+};
+
+using EngineFactory = std::unique_ptr<ExecutionEngine>(*)(EngineContext& ctx) noexcept;
+
+struct EngineInfo final
+{
+public:
+    EngineID         ID{};
+    std::string_view Name{};
+    EngineFactory    Create{};
+    bool             Calibrate{}; // Considered when picking an engine automatically
+};
+
+[[nodiscard]] std::span<const EngineInfo> GetEngines() noexcept;
+[[nodiscard]] std::string_view GetEngineName(EngineID id) noexcept;
+[[nodiscard]] std::optional<EngineID> ParseEngineID(std::string_view name) noexcept;
+
+[[nodiscard]] std::unique_ptr<ExecutionEngine> CreateEngine(EngineID id, EngineContext& ctx) noexcept;
+
+// Runs every calibrated engine for a number of frames on a copy of the given
+// state and returns the one with the highest throughput
+[[nodiscard]] EngineID CalibrateEngines(const CPUData& cpu, const RAM& ram, u32 instructionsPerFrame) noexcept;
+
+}
@@ -0,0 +1,420 @@
+#pragma once
+
+#include "CPU.hpp"
+#include "Instructions.hpp"
+#include "RAM.hpp"
+
+#include "Core/Debug.hpp"
+#include "Core/Platform.hpp"
+#include "Core/Random.hpp"
+
+#include <algorithm>
+
+// Pairs every decoded instruction with the executor implementing it. Kept in
+// one place so that the dispatch tables of every engine stay in sync with
+// the Instr enumeration
+#define C8_FOR_EACH_INSTR(X)   \
+    X(RAW,          Raw)       \
+    X(CLS,          Cls)       \
+    X(RET,          Ret)       \
+    X(JP_ADDR,      JpAddr)    \
+    X(JP_V0_ADDR,   JpV0Addr)  \
+    X(CALL_ADDR,    CallAddr)  \
+    X(SE_VX_BYTE,   SeVxByte)  \
+    X(SE_VX_VY,     SeVxVy)    \
+    X(SNE_VX_BYTE,  SneVxByte) \
+    X(SNE_VX_VY,    SneVxVy)   \
+    X(LD_VX_BYTE,   LdVxByte)  \
+    X(LD_VX_VY,     LdVxVy)    \
+    X(LD_I_ADDR,    LdIAddr)   \
+    X(LD_VX_DT,     LdVxDt)    \
+    X(LD_VX_KEY,    LdVxKey)   \
+    X(LD_DT_VX,     LdDtVx)    \
+    X(LD_ST_VX,     LdStVx)    \
+    X(LD_FONT_VX,   LdFontVx)  \
+    X(LD_BCD_VX,    LdBcdVx)   \
+    X(LD_ADDR_I_VX, LdAddrIVx) \
+    X(LD_VX_ADDR_I, LdVxAddrI) \
+    X(ADD_VX_BYTE,  AddVxByte) \
+    X(ADD_VX_VY,    AddVxVy)   \
+    X(ADD_I_VX,     AddIVx)    \
+    X(OR_VX_VY,     OrVxVy)    \
+    X(AND_VX_VY,    AndVxVy)   \
+    X(XOR_VX_VY,    XorVxVy)   \
+    X(SUB_VX_VY,    SubVxVy)   \
+    X(SHR_VX_VY,    ShrVxVy)   \
+    X(SUBN_VX_VY,   SubnVxVy)  \
+    X(SHL_VX_VY,    ShlVxVy)   \
+    X(RND_VX_BYTE,  RndVxByte) \
+    X(DRW_VX_VY_N,  DrwVxVyN)  \
+    X(SKP_VX,       SkpVx)     \
+    X(SKNP_VX,      SknpVx)
+
+namespace c8emu {
+
+inline void Raw(UNUSED CPUData& cpu, UNUSED RAM& ram, UNUSED const OpCode& op) noexcept
+{
+    C8_LOG_ERROR("Unsupported opcode detected (0x{:X})", op.raw);
+}
+
+inline void Cls(CPUData& cpu, UNUSED RAM& ram, UNUSED const OpCode& op) noexcept
+{
+    for (size_t y{}; y < cpu.Video.size(); y++)
+        cpu.Dirty |= static_cast<DirtyRows>(cpu.Video[y] != 0) << y;
+
+    cpu.Video.fill(0x00);
+}
+
+inline void Ret(CPUData& cpu, UNUSED RAM& ram, UNUSED const OpCode& op) noexcept
+{
+    cpu.PC = cpu.CallStack.PopAddr();
+}
+
+inline void JpAddr(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.PC = op.nnn;
+}
+
+inline void JpV0Addr(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.PC = cpu.Registers[RegisterID::V0] + op.nnn;
+}
+
+inline void CallAddr(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.CallStack.PushAddr(cpu.PC);
+    cpu.PC = op.nnn;
+}
+
+inline void SeVxByte(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    if (cpu.Registers[op.x] == op.kk)
+        cpu.PC += 2;
+}
+
+inline void SeVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    if (cpu.Registers[op.x] == cpu.Registers[op.y])
+        cpu.PC += 2;
+}
+
+inline void SneVxByte(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    if (cpu.Registers[op.x] != op.kk)
+        cpu.PC += 2;
+}
+
+inline void SneVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    if (cpu.Registers[op.x] != cpu.Registers[op.y])
+        cpu.PC += 2;
+}
+
+inline void LdVxByte(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] = op.kk;
+}
+
+inline void LdVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] = cpu.Registers[op.y];
+}
+
+inline void LdIAddr(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Idx = op.nnn;
+}
+
+inline void LdVxDt(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] = cpu.DT;
+}
+
+inline void LdVxKey(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    // The wait itself is driven by CPU::SetKey, the instruction only starts
+    // it and picks up the key once it has been released
+    if (cpu.Wait == KeyWait::RELEASED)
+    {
+        cpu.Registers[op.x] = cpu.WaitKey;
+        cpu.Wait = KeyWait::NONE;
+        return;
+    }
+
+    if (cpu.Wait == KeyWait::NONE)
+        cpu.Wait = KeyWait::WAITING;
+
+    cpu.PC -= 2;
+}
+
+inline void LdDtVx(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.DT = cpu.Registers[op.x];
+}
+
+inline void LdStVx(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.ST = cpu.Registers[op.x];
+}
+
+inline void LdFontVx(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 digit = cpu.Registers[op.x];
+    cpu.Idx = C8_ADDR_FONT + (5 * digit);
+}
+
+inline void LdBcdVx(CPUData& cpu, RAM& ram, const OpCode& op) noexcept
+{
+    u8 value = cpu.Registers[op.x];
+    ram.Write(cpu.Idx + 2, value % 10);
+    value /= 10;
+
+    ram.Write(cpu.Idx + 1, value % 10);
+    value /= 10;
+
+    ram.Write(cpu.Idx + 0, value % 10);
+}
+
+inline void LdAddrIVx(CPUData& cpu, RAM& ram, const OpCode& op) noexcept
+{
+    for (u8 i{}; i <= op.x; i++)
+        ram.Write(cpu.Idx++, cpu.Registers[i]);
+}
+
+inline void LdVxAddrI(CPUData& cpu, RAM& ram, const OpCode& op) noexcept
+{
+    for (u8 i{}; i <= op.x; i++)
+        cpu.Registers[i] = ram[cpu.Idx++];
+}
+
+inline void AddVxByte(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u16 sum = static_cast<u16>(cpu.Registers[op.x]) + static_cast<u16>(op.kk);
+    cpu.Registers[op.x] = static_cast<u8>(sum & 0x00FF);
+    cpu.Registers[RegisterID::VF] = sum > 0x00FF;
+}
+
+inline void AddVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u16 sum = static_cast<u16>(cpu.Registers[op.x]) + static_cast<u16>(cpu.Registers[op.y]);
+    cpu.Registers[op.x] = static_cast<u8>(sum & 0x00FF);
+    cpu.Registers[RegisterID::VF] = sum > 0x00FF;
+}
+
+inline void AddIVx(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Idx += cpu.Registers[op.x];
+}
+
+inline void OrVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] |= cpu.Registers[op.y];
+    cpu.Registers[RegisterID::VF] = 0;
+}
+
+inline void AndVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] &= cpu.Registers[op.y];
+    cpu.Registers[RegisterID::VF] = 0;
+}
+
+inline void XorVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] ^= cpu.Registers[op.y];
+    cpu.Registers[RegisterID::VF] = 0;
+}
+
+inline void SubVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u16 diff = static_cast<u16>(cpu.Registers[op.x]) - static_cast<u16>(cpu.Registers[op.y]);
+    cpu.Registers[op.x] = static_cast<u8>(diff & 0x00FF);
+    cpu.Registers[RegisterID::VF] = diff <= 0x00FF;
+}
+
+inline void ShrVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 bit = cpu.Registers[op.y] & 0x01;
+    cpu.Registers[op.x] = cpu.Registers[op.y] >> 1;
+    cpu.Registers[RegisterID::VF] = bit > 0;
+}
+
+inline void SubnVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u16 diff = static_cast<u16>(cpu.Registers[op.y]) - static_cast<u16>(cpu.Registers[op.x]);
+    cpu.Registers[op.x] = static_cast<u8>(diff & 0x00FF);
+    cpu.Registers[RegisterID::VF] = diff <= 0x00FF;
+}
+
+inline void ShlVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 bit = cpu.Registers[op.y] & 0x80;
+    cpu.Registers[op.x] = cpu.Registers[op.y] << 1;
+    cpu.Registers[RegisterID::VF] = bit > 0;
+}
+
+inline void RndVxByte(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] = Random::GetValue<u8>() & op.kk;
+}
+
+// Each sprite row is shifted into place across a whole display row, which
+// clips it at the right edge. Collisions are whatever the two have in common.
+inline void DrwVxVyN(CPUData& cpu, RAM& ram, const OpCode& op) noexcept
+{
+    const u32 x0 = cpu.Registers[op.x] % C8_SCREEN_BUFFER_WIDTH<u32>;
+    const u32 y0 = cpu.Registers[op.y] % C8_SCREEN_BUFFER_HEIGHT<u32>;
+    const u32 height = std::min<u32>(op.n, C8_SCREEN_BUFFER_HEIGHT<u32> - y0);
+
+    VideoRow collision{};
+    for (u32 vy{}; vy < height; vy++)
+    {
+        const VideoRow sprite = (static_cast<VideoRow>(ram[cpu.Idx + vy]) << (C8_VIDEO_ROW_BITS - 8)) >> x0;
+
+        VideoRow& row = cpu.Video[y0 + vy];
+        collision |= row & sprite;
+        row ^= sprite;
+        cpu.Dirty |= static_cast<DirtyRows>(sprite != 0) << (y0 + vy);
+    }
+
+    cpu.Registers[RegisterID::VF] = collision != 0;
+}
+
+inline void SkpVx(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 key = cpu.Registers[op.x];
+    if (cpu.Keypad[key])
+        cpu.PC += 2;
+}
+
+inline void SknpVx(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 key = cpu.Registers[op.x];
+    if (!cpu.Keypad[key])
+        cpu.PC += 2;
+}
+
+#define C8_EXECUTOR_ENTRY(instr, proc) proc,
+
+inline constexpr ExecProc C8_EXECUTORS[] = {
+    C8_FOR_EACH_INSTR(C8_EXECUTOR_ENTRY)
+};
+
+#undef C8_EXECUTOR_ENTRY
+
+static_assert(std::size(C8_EXECUTORS) == static_cast<size_t>(Instr::COUNT));
+
+// --- lazy flags -------------------------------------------------------------
+
+// Same as their eager counterparts, except that VF is left pending. Only
+// valid for instructions that don't touch VF themselves (OpCode::vf).
+
+inline void LazyAddVxByte(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 vx = cpu.Registers[op.x];
+    cpu.Registers[op.x] = static_cast<u8>(vx + op.kk);
+    cpu.Flag = { FlagOp::CARRY, vx, op.kk };
+}
+
+inline void LazyAddVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 vx = cpu.Registers[op.x];
+    const u8 vy = cpu.Registers[op.y];
+    cpu.Registers[op.x] = static_cast<u8>(vx + vy);
+    cpu.Flag = { FlagOp::CARRY, vx, vy };
+}
+
+inline void LazyOrVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] |= cpu.Registers[op.y];
+    cpu.Flag.Op = FlagOp::ZERO;
+}
+
+inline void LazyAndVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] &= cpu.Registers[op.y];
+    cpu.Flag.Op = FlagOp::ZERO;
+}
+
+inline void LazyXorVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    cpu.Registers[op.x] ^= cpu.Registers[op.y];
+    cpu.Flag.Op = FlagOp::ZERO;
+}
+
+inline void LazySubVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 vx = cpu.Registers[op.x];
+    const u8 vy = cpu.Registers[op.y];
+    cpu.Registers[op.x] = static_cast<u8>(vx - vy);
+    cpu.Flag = { FlagOp::NO_BORROW, vx, vy };
+}
+
+inline void LazyShrVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 vy = cpu.Registers[op.y];
+    cpu.Registers[op.x] = vy >> 1;
+    cpu.Flag = { FlagOp::LSB, vy, 0 };
+}
+
+inline void LazySubnVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 vx = cpu.Registers[op.x];
+    const u8 vy = cpu.Registers[op.y];
+    cpu.Registers[op.x] = static_cast<u8>(vy - vx);
+    cpu.Flag = { FlagOp::NO_BORROW, vy, vx };
+}
+
+inline void LazyShlVxVy(CPUData& cpu, UNUSED RAM& ram, const OpCode& op) noexcept
+{
+    const u8 vy = cpu.Registers[op.y];
+    cpu.Registers[op.x] = static_cast<u8>(vy << 1);
+    cpu.Flag = { FlagOp::MSB, vy, 0 };
+}
+
+// Writes any pending flag before running an instruction that touches VF
+template<ExecProc Proc>
+inline void Materialized(CPUData& cpu, RAM& ram, const OpCode& op) noexcept
+{
+    MaterializeFlag(cpu);
+    Proc(cpu, ram, op);
+}
+
+using ExecutorTable = std::array<ExecProc, static_cast<size_t>(Instr::COUNT)>;
+
+[[nodiscard]] constexpr ExecutorTable MakeLazyExecutors() noexcept
+{
+    ExecutorTable table{};
+    for (size_t i{}; i < table.size(); i++)
+        table[i] = C8_EXECUTORS[i];
+
+    table[static_cast<size_t>(Instr::ADD_VX_BYTE)] = LazyAddVxByte;
+    table[static_cast<size_t>(Instr::ADD_VX_VY)] = LazyAddVxVy;
+    table[static_cast<size_t>(Instr::OR_VX_VY)] = LazyOrVxVy;
+    table[static_cast<size_t>(Instr::AND_VX_VY)] = LazyAndVxVy;
+    table[static_cast<size_t>(Instr::XOR_VX_VY)] = LazyXorVxVy;
+    table[static_cast<size_t>(Instr::SUB_VX_VY)] = LazySubVxVy;
+    table[static_cast<size_t>(Instr::SHR_VX_VY)] = LazyShrVxVy;
+    table[static_cast<size_t>(Instr::SUBN_VX_VY)] = LazySubnVxVy;
+    table[static_cast<size_t>(Instr::SHL_VX_VY)] = LazyShlVxVy;
+
+    return table;
+}
+
+inline constexpr ExecutorTable C8_LAZY_EXECUTORS = MakeLazyExecutors();
+
+#define C8_MATERIALIZED_ENTRY(instr, proc) Materialized<proc>,
+
+inline constexpr ExecProc C8_MATERIALIZED_EXECUTORS[] = {
+    C8_FOR_EACH_INSTR(C8_MATERIALIZED_ENTRY)
+};
+
+#undef C8_MATERIALIZED_ENTRY
+
+// The executor to use for an instruction when flags are evaluated lazily
+[[nodiscard]] constexpr ExecProc SelectExecutor(const OpCode& op) noexcept
+{
+    const size_t idx = static_cast<size_t>(op.instr);
+    return op.vf ? C8_MATERIALIZED_EXECUTORS[idx] : C8_LAZY_EXECUTORS[idx];
+}
+
+}
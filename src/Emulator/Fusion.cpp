@@ -0,0 +1,93 @@
+#include "Fusion.hpp"
+#include "Executors.hpp"
+
+namespace c8emu {
+
+// The program counter already points past the block when these run, exactly
+// as it would for the block's last instruction on its own
+
+static u32 WaitDelay(CPUData& cpu, UNUSED RAM& ram, const OpCode& load, UNUSED const OpCode& skip) noexcept
+{
+    cpu.Registers[load.x] = cpu.DT;
+    if (cpu.Registers[load.x] == 0)
+    {
+        cpu.PC += 2;
+        return 2;
+    }
+
+    // Take the jump back to the load
+    cpu.PC -= 4;
+    return 3;
+}
+
+static u32 LoadDelaySkip(CPUData& cpu, UNUSED RAM& ram, const OpCode& load, UNUSED const OpCode& skip) noexcept
+{
+    cpu.Registers[load.x] = cpu.DT;
+    if (cpu.Registers[load.x] == 0)
+        cpu.PC += 2;
+
+    return 2;
+}
+
+static u32 LoadDraw(CPUData& cpu, RAM& ram, const OpCode& load, const OpCode& draw) noexcept
+{
+    cpu.Idx = load.nnn;
+
+    MaterializeFlag(cpu);
+    DrwVxVyN(cpu, ram, draw);
+    return 2;
+}
+
+template<bool Equal>
+static u32 AddSkip(CPUData& cpu, RAM& ram, const OpCode& add, const OpCode& skip) noexcept
+{
+    LazyAddVxByte(cpu, ram, add);
+    if ((cpu.Registers[add.x] == skip.kk) == Equal)
+        cpu.PC += 2;
+
+    return 2;
+}
+
+void FuseBlock(const RAM& ram, Block& block) noexcept
+{
+    if (block.Length < 2)
+        return;
+
+    const OpCode& first = block.Ops[block.Length - 2].op;
+    const OpCode& last = block.Ops[block.Length - 1].op;
+
+    if (first.instr == Instr::LD_I_ADDR && last.instr == Instr::DRW_VX_VY_N)
+    {
+        block.Fused = LoadDraw;
+        return;
+    }
+
+    // The remaining idioms work on a single register other than VF
+    if (first.x != last.x || first.vf)
+        return;
+
+    if (first.instr == Instr::ADD_VX_BYTE && last.instr == Instr::SE_VX_BYTE)
+        block.Fused = AddSkip<true>;
+    else if (first.instr == Instr::ADD_VX_BYTE && last.instr == Instr::SNE_VX_BYTE)
+        block.Fused = AddSkip<false>;
+    else if (first.instr == Instr::LD_VX_DT && last.instr == Instr::SE_VX_BYTE && last.kk == 0)
+    {
+        block.Fused = LoadDelaySkip;
+
+        // Pull in the jump that closes the loop, if there is one
+        const Address load = static_cast<Address>(block.Entry + 2 * (block.Length - 2));
+        const Address next = static_cast<Address>(load + 4);
+        if (static_cast<size_t>(next) + 1 >= C8_MEMORY_SIZE)
+            return;
+
+        const u16 raw = (static_cast<u16>(ram[next]) << 8) | static_cast<u16>(ram[next + 1]);
+        const OpCode jump = Decode(raw);
+        if (jump.instr == Instr::JP_ADDR && jump.nnn == load)
+        {
+            block.Fused = WaitDelay;
+            block.Lookahead = 1;
+        }
+    }
+}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "BlockCache.hpp"
+#include "RAM.hpp"
+
+namespace c8emu {
+
+// Peephole pass that replaces the tail of `block` with a superinstruction if
+// it matches one of the common idioms:
+//
+//   LD Vx, DT / SE Vx, 0 / JP <back>   (delay loop)
+//   LD I, nnn / DRW Vx, Vy, n          (sprite draw)
+//   ADD Vx, kk / SE Vx, kk             (counter, SNE as well)
+void FuseBlock(const RAM& ram, Block& block) noexcept;
+
+}
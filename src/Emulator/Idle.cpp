@@ -0,0 +1,99 @@
+#include "Idle.hpp"
+#include "Instructions.hpp"
+
+namespace c8emu {
+
+static OpCode FetchOpCode(const RAM& ram, size_t addr) noexcept
+{
+    if (addr + 1 >= C8_MEMORY_SIZE)
+        return {};
+
+    const Address pc = static_cast<Address>(addr);
+    const u16 raw = (static_cast<u16>(ram[pc]) << 8) | static_cast<u16>(ram[pc + 1]);
+    return Decode(raw);
+}
+
+static bool JumpsTo(const OpCode& op, size_t addr) noexcept
+{
+    return op.instr == Instr::JP_ADDR && op.nnn == addr;
+}
+
+// Checks whether the loop of `length` instructions starting at `head` is
+// idle, given that execution is currently `phase` instructions into it.
+// Entering halfway is only allowed when the rest of the iteration can't
+// leave the loop either.
+static bool IsIdleLoop(const CPUData& cpu, const RAM& ram, size_t head, u8 length, u8 phase) noexcept
+{
+    const OpCode first = FetchOpCode(ram, head);
+    switch (length)
+    {
+        case 1:
+            return JumpsTo(first, head);
+        case 2:
+        {
+            if (first.instr != Instr::SKP_VX && first.instr != Instr::SKNP_VX)
+                return false;
+
+            if (!JumpsTo(FetchOpCode(ram, head + 2), head))
+                return false;
+
+            const u8 key = cpu.Registers[first.x];
+            if (key >= C8_NUM_KEYS)
+                return false;
+
+            // SKP spins until the key goes down, SKNP until it comes up
+            return (cpu.Keypad[key] != 0) == (first.instr == Instr::SKNP_VX);
+        }
+        case 3:
+        {
+            const OpCode test = FetchOpCode(ram, head + 2);
+            if (first.instr != Instr::LD_VX_DT || test.instr != Instr::SE_VX_BYTE || test.x != first.x)
+                return false;
+
+            if (!JumpsTo(FetchOpCode(ram, head + 4), head))
+                return false;
+
+            // The test may still see a value loaded before the timer ticked
+            if (phase == 1 && cpu.Registers[first.x] == test.kk)
+                return false;
+
+            return cpu.DT != test.kk;
+        }
+        default:
+            return false;
+    }
+}
+
+u32 SkipIdleLoop(CPUData& cpu, const RAM& ram, u32 count) noexcept
+{
+    const size_t pc = static_cast<size_t>(cpu.PC);
+
+    for (u8 length = 1; length <= 3; length++)
+    {
+        for (u8 phase{}; phase < length; phase++)
+        {
+            if (pc < 2 * static_cast<size_t>(phase))
+                break;
+
+            const size_t head = pc - 2 * static_cast<size_t>(phase);
+            if (!IsIdleLoop(cpu, ram, head, length, phase))
+                continue;
+
+            // The only side effect of the delay poll is its load, which
+            // happens once the current iteration wraps around
+            const u32 untilHead = (length - phase) % length;
+            if (length == 3 && count > untilHead)
+            {
+                const OpCode load = FetchOpCode(ram, head);
+                cpu.Registers[load.x] = cpu.DT;
+            }
+
+            cpu.PC = static_cast<u16>(head + 2 * ((phase + count) % length));
+            return count;
+        }
+    }
+
+    return 0;
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CPU.hpp"
+#include "RAM.hpp"
+
+namespace c8emu {
+
+// Detects whether the program counter sits in a loop that can't leave before
+// the next timer decrement or key event, and if so runs `count` instructions
+// of it in one go:
+//
+//   JP <self>                          (halt)
+//   SKP/SKNP Vx / JP <back>            (key poll)
+//   LD Vx, DT / SE Vx, kk / JP <back>  (delay poll)
+//
+// Returns the number of instructions skipped, which is either `count` or
+// zero if the loop isn't idle. VF must not have a pending flag.
+[[nodiscard]] u32 SkipIdleLoop(CPUData& cpu, const RAM& ram, u32 count) noexcept;
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Spec.hpp"
+
+#include "Core/Types.hpp"
+
+namespace c8emu {
+
+// Frontends translate whatever their windowing library reports into presses
+// and releases of the hex keypad, which keeps the emulator free of any such
+// dependency
+struct KeyEvent final
+{
+public:
+    u8 Key{};
+    u8 Value{};
+};
+
+[[nodiscard]] constexpr bool IsValidKey(u8 key) noexcept
+{
+    return static_cast<size_t>(key) < C8_NUM_KEYS;
+}
+
+}
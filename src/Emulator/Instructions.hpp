@@ -2,118 +2,276 @@
 
 #include "Core/Types.hpp"
 
-#include <variant>
+#include <array>
+#include <type_traits>
 
 namespace c8emu {
 
+// Forward declerations
+struct CPUData;
+class RAM;
+
+// Every (instruction, address mode) pair gets its own entry so that the
+// executors can be dispatched through a single table lookup
 enum class Instr : u8
 {
     RAW,
     CLS,
     RET,
-    JP,
-    CALL,
-    SE,
-    SNE,
-    LD,
-    ADD,
-    OR,
-    AND,
-    XOR,
-    SUB,
-    SHR,
-    SUBN,
-    SHL,
-    RND,
-    DRW,
-    SKP,
-    SKNP
-};
+    JP_ADDR,
+    JP_V0_ADDR,
+    CALL_ADDR,
+    SE_VX_BYTE,
+    SE_VX_VY,
+    SNE_VX_BYTE,
+    SNE_VX_VY,
+    LD_VX_BYTE,
+    LD_VX_VY,
+    LD_I_ADDR,
+    LD_VX_DT,
+    LD_VX_KEY,
+    LD_DT_VX,
+    LD_ST_VX,
+    LD_FONT_VX,
+    LD_BCD_VX,
+    LD_ADDR_I_VX,
+    LD_VX_ADDR_I,
+    ADD_VX_BYTE,
+    ADD_VX_VY,
+    ADD_I_VX,
+    OR_VX_VY,
+    AND_VX_VY,
+    XOR_VX_VY,
+    SUB_VX_VY,
+    SHR_VX_VY,
+    SUBN_VX_VY,
+    SHL_VX_VY,
+    RND_VX_BYTE,
+    DRW_VX_VY_N,
+    SKP_VX,
+    SKNP_VX,
 
-enum class AddrMode : u32
-{
-    NONE      = 0,
-    OPCODE    = 1 << 0,
-    ADDR      = 1 << 1,
-    VX_BYTE   = 1 << 2,
-    VX_VY     = 1 << 3,
-    I_ADDR    = 1 << 4,
-    V0_ADDR   = 1 << 5,
-    VX_VY_N   = 1 << 6,
-    VX        = 1 << 7,
-    VX_DT     = 1 << 8,
-    VX_KEY    = 1 << 9,
-    DT_VX     = 1 << 10,
-    ST_VX     = 1 << 11,
-    I_VX      = 1 << 12,
-    FONT_VX   = 1 << 13,
-    BCD_VX    = 1 << 14,
-    ADDR_I_VX = 1 << 15,
-    VX_ADDR_I = 1 << 16,
+    COUNT
 };
 
-constexpr size_t operator|(AddrMode a, AddrMode b) noexcept { return static_cast<size_t>(a) | static_cast<size_t>(b); }
-constexpr size_t operator&(AddrMode a, AddrMode b) noexcept { return static_cast<size_t>(a) & static_cast<size_t>(b); }
-constexpr size_t operator&(AddrMode a, size_t b) noexcept { return static_cast<size_t>(a) & b; }
-constexpr size_t operator|(size_t a, AddrMode b) noexcept { return a | static_cast<size_t>(b); }
-
-struct VxByte final
+struct OpCode final
 {
 public:
-    u8   x;
-    Byte byte;
+    u16   raw{};
+    u16   nnn{};
+    Instr instr{};
+    u8    x{};
+    u8    y{};
+    u8    n{};
+    u8    kk{};
+    bool  vf{}; // Reads or writes VF, so any pending flag must be written first
 
 public:
-    constexpr VxByte(u16 raw) noexcept;
+    constexpr OpCode() noexcept = default;
+    constexpr explicit OpCode(u16 raw) noexcept;
 };
 
-struct VxVy final
+static_assert(std::is_trivially_copyable_v<OpCode>);
+
+using ExecProc = void(*)(CPUData&, RAM&, const OpCode&) noexcept;
+
+[[nodiscard]] constexpr Instr DecodeInstr(u16 raw) noexcept
 {
-public:
-    u8 x, y;
+    switch ((raw & 0xF000) >> 12)
+    {
+        case 0x0:
+        {
+            switch (raw & 0x00FF)
+            {
+                case 0xE0: return Instr::CLS;
+                case 0xEE: return Instr::RET;
+                default:   return Instr::RAW;
+            }
+        }
+        case 0x1: return Instr::JP_ADDR;
+        case 0x2: return Instr::CALL_ADDR;
+        case 0x3: return Instr::SE_VX_BYTE;
+        case 0x4: return Instr::SNE_VX_BYTE;
+        case 0x5: return Instr::SE_VX_VY;
+        case 0x6: return Instr::LD_VX_BYTE;
+        case 0x7: return Instr::ADD_VX_BYTE;
+        case 0x8:
+        {
+            switch (raw & 0x000F)
+            {
+                case 0x0: return Instr::LD_VX_VY;
+                case 0x1: return Instr::OR_VX_VY;
+                case 0x2: return Instr::AND_VX_VY;
+                case 0x3: return Instr::XOR_VX_VY;
+                case 0x4: return Instr::ADD_VX_VY;
+                case 0x5: return Instr::SUB_VX_VY;
+                case 0x6: return Instr::SHR_VX_VY;
+                case 0x7: return Instr::SUBN_VX_VY;
+                case 0xE: return Instr::SHL_VX_VY;
+                default:  return Instr::RAW;
+            }
+        }
+        case 0x9: return Instr::SNE_VX_VY;
+        case 0xA: return Instr::LD_I_ADDR;
+        case 0xB: return Instr::JP_V0_ADDR;
+        case 0xC: return Instr::RND_VX_BYTE;
+        case 0xD: return Instr::DRW_VX_VY_N;
+        case 0xE:
+        {
+            switch (raw & 0x00FF)
+            {
+                case 0x9E: return Instr::SKP_VX;
+                case 0xA1: return Instr::SKNP_VX;
+                default:   return Instr::RAW;
+            }
+        }
+        case 0xF:
+        {
+            switch (raw & 0x00FF)
+            {
+                case 0x07: return Instr::LD_VX_DT;
+                case 0x0A: return Instr::LD_VX_KEY;
+                case 0x15: return Instr::LD_DT_VX;
+                case 0x18: return Instr::LD_ST_VX;
+                case 0x1E: return Instr::ADD_I_VX;
+                case 0x29: return Instr::LD_FONT_VX;
+                case 0x33: return Instr::LD_BCD_VX;
+                case 0x55: return Instr::LD_ADDR_I_VX;
+                case 0x65: return Instr::LD_VX_ADDR_I;
+                default:   return Instr::RAW;
+            }
+        }
+        default:
+            return Instr::RAW;
+    }
+}
 
-public:
-    constexpr VxVy(u16 raw) noexcept;
-};
+// Arithmetic instructions whose VF result can be computed lazily
+[[nodiscard]] constexpr bool ProducesFlag(Instr instr) noexcept
+{
+    switch (instr)
+    {
+        case Instr::ADD_VX_BYTE:
+        case Instr::ADD_VX_VY:
+        case Instr::OR_VX_VY:
+        case Instr::AND_VX_VY:
+        case Instr::XOR_VX_VY:
+        case Instr::SUB_VX_VY:
+        case Instr::SHR_VX_VY:
+        case Instr::SUBN_VX_VY:
+        case Instr::SHL_VX_VY:
+            return true;
+        default:
+            return false;
+    }
+}
 
-struct VxVyN final
+[[nodiscard]] constexpr bool TouchesVF(Instr instr, u8 x, u8 y) noexcept
 {
-public:
-    u8 x, y, n;
+    switch (instr)
+    {
+        case Instr::RAW:
+        case Instr::CLS:
+        case Instr::RET:
+        case Instr::JP_ADDR:
+        case Instr::JP_V0_ADDR:
+        case Instr::CALL_ADDR:
+        case Instr::LD_I_ADDR:
+            return false;
+        case Instr::DRW_VX_VY_N:
+            return true;
+        case Instr::SE_VX_VY:
+        case Instr::SNE_VX_VY:
+        case Instr::LD_VX_VY:
+        case Instr::ADD_VX_VY:
+        case Instr::OR_VX_VY:
+        case Instr::AND_VX_VY:
+        case Instr::XOR_VX_VY:
+        case Instr::SUB_VX_VY:
+        case Instr::SHR_VX_VY:
+        case Instr::SUBN_VX_VY:
+        case Instr::SHL_VX_VY:
+            return x == 0x0F || y == 0x0F;
+        default:
+            return x == 0x0F;
+    }
+}
 
-public:
-    constexpr VxVyN(u16 raw) noexcept;
-};
+constexpr OpCode::OpCode(u16 raw) noexcept :
+    raw(raw),
+    nnn(raw & 0x0FFF),
+    instr(DecodeInstr(raw)),
+    x(static_cast<u8>((raw & 0x0F00) >> 8)),
+    y(static_cast<u8>((raw & 0x00F0) >> 4)),
+    n(static_cast<u8>(raw & 0x000F)),
+    kk(static_cast<u8>(raw & 0x00FF)),
+    vf(TouchesVF(instr, x, y)) {}
+
+static_assert(OpCode(0x00E0).instr == Instr::CLS);
+static_assert(OpCode(0xF133).instr == Instr::LD_BCD_VX && OpCode(0xF133).x == 0x1);
+static_assert(OpCode(0xD12F).instr == Instr::DRW_VX_VY_N && OpCode(0xD12F).n == 0xF);
+static_assert(OpCode(0x8F14).vf && OpCode(0x81F4).vf && !OpCode(0x8124).vf);
+static_assert(OpCode(0xFF65).vf && !OpCode(0xFE65).vf);
 
-struct VxAddr final
+// Instructions that store to memory and may therefore overwrite code that has
+// already been decoded
+[[nodiscard]] constexpr bool WritesMemory(Instr instr) noexcept
 {
-public:
-    Address addr;
-    u8      x;
+    return instr == Instr::LD_BCD_VX || instr == Instr::LD_ADDR_I_VX;
+}
 
-public:
-    constexpr VxAddr(u16 raw) noexcept;
-};
+// Instructions after which execution may not simply fall through to the next
+// address, or which may have modified code that follows them
+[[nodiscard]] constexpr bool EndsBlock(Instr instr) noexcept
+{
+    switch (instr)
+    {
+        case Instr::RET:
+        case Instr::JP_ADDR:
+        case Instr::JP_V0_ADDR:
+        case Instr::CALL_ADDR:
+        case Instr::SE_VX_BYTE:
+        case Instr::SE_VX_VY:
+        case Instr::SNE_VX_BYTE:
+        case Instr::SNE_VX_VY:
+        case Instr::SKP_VX:
+        case Instr::SKNP_VX:
+        case Instr::DRW_VX_VY_N:
+        case Instr::LD_VX_KEY:
+            return true;
+        default:
+            return WritesMemory(instr);
+    }
+}
 
+// --- lookup table -----------------------------------------------------------
 
-struct OpCode final
+constexpr size_t C8_NUM_OPCODES = 0x10000;
+
+using DecodeTable = std::array<OpCode, C8_NUM_OPCODES>;
+
+// The table is built from the same constructor as the compact decoder, so
+// the two can never disagree
+[[nodiscard]] constexpr DecodeTable MakeDecodeTable() noexcept
 {
-public:
-    using Args = std::variant<Address, VxByte, VxVy, VxVyN, VxAddr, u8>;
+    DecodeTable table{};
+    for (size_t raw{}; raw < C8_NUM_OPCODES; raw++)
+        table[raw] = OpCode(static_cast<u16>(raw));
 
-public:
-    Instr    instr{};
-    AddrMode addressMode{};
-    Args     args{};
+    return table;
+}
 
-public:
-    explicit OpCode(u16 raw) noexcept;
+#if defined(C8_DECODE_LUT)
+extern const DecodeTable C8_DECODE_TABLE;
+#endif
 
-    template<typename T>
-    [[nodiscard]] constexpr T GetArgs() const noexcept
-    {
-        return std::get<T>(args);
-    }
-};
+[[nodiscard]] inline OpCode Decode(u16 raw) noexcept
+{
+#if defined(C8_DECODE_LUT)
+    return C8_DECODE_TABLE[static_cast<size_t>(raw)];
+#else
+    return OpCode(raw);
+#endif
+}
 
 }
@@ -0,0 +1,330 @@
+#include "JIT.hpp"
+#include "Blocks.hpp"
+#include "CPU.hpp"
+#include "CodeCache.hpp"
+#include "Executors.hpp"
+#include "X64Emitter.hpp"
+
+#if defined(C8_JIT)
+
+#if !defined(C8_PLATFORM_LINUX) || !defined(__x86_64__)
+#error "The JIT is only supported on Linux x86-64"
+#endif
+
+#include <algorithm>
+#include <cstddef>
+
+namespace c8emu {
+
+static_assert(sizeof(Registers) == C8_NUM_REGISTERS);
+
+static constexpr i32 OFFSET_PC  = static_cast<i32>(offsetof(CPUData, PC));
+static constexpr i32 OFFSET_IDX = static_cast<i32>(offsetof(CPUData, Idx));
+static constexpr i32 OFFSET_DT  = static_cast<i32>(offsetof(CPUData, DT));
+static constexpr i32 OFFSET_ST  = static_cast<i32>(offsetof(CPUData, ST));
+
+static constexpr i32 V(u8 x) noexcept { return static_cast<i32>(offsetof(CPUData, Registers)) + x; }
+
+static void EmitBlock(X64Emitter& emit, const Block& block, size_t& entry) noexcept;
+static void EmitOp(X64Emitter& emit, const OpCode& op, const void* data) noexcept;
+
+// --- cache ------------------------------------------------------------------
+
+NativeBlock JitCache::Compile(const Block& block) noexcept
+{
+    for (u32 attempt{}; attempt < 2; attempt++)
+    {
+        m_Buffer.BeginWrite();
+
+        u8* begin = m_Buffer.GetCursor();
+        X64Emitter emit(begin, m_Buffer.GetRemaining());
+
+        size_t entry{};
+        EmitBlock(emit, block, entry);
+        if (emit.HasOverflowed())
+        {
+            // Out of space, start over with an empty buffer
+            m_Buffer.EndWrite(0);
+            Clear();
+            continue;
+        }
+
+        m_Buffer.EndWrite(emit.GetSize());
+
+        const size_t pc = static_cast<size_t>(block.Entry);
+        for (size_t i{}; i < 2 * static_cast<size_t>(block.Length); i++)
+            m_CodeMap[(pc + i) & 0x0FFF]++;
+
+        m_Native[pc] = reinterpret_cast<NativeBlock>(begin + entry);
+        m_Length[pc] = block.Length;
+        return m_Native[pc];
+    }
+
+    return nullptr;
+}
+
+void JitCache::Invalidate(DirtyRange range) noexcept
+{
+    for (Address addr = range.Begin; addr < range.End; addr++)
+    {
+        if (m_CodeMap[static_cast<size_t>(addr & 0x0FFF)] == 0)
+            continue;
+
+        for (size_t entry{}; entry < C8_MEMORY_SIZE; entry++)
+        {
+            const size_t offset = (static_cast<size_t>(addr) - entry) & 0x0FFF;
+            if (m_Native[entry] && offset < 2 * static_cast<size_t>(m_Length[entry]))
+                Evict(entry);
+        }
+    }
+}
+
+void JitCache::Clear() noexcept
+{
+    m_Native.fill(nullptr);
+    m_Length.fill(0);
+    m_Heat.fill(0);
+    m_CodeMap.fill(0);
+    m_Buffer.Reset();
+}
+
+void JitCache::Evict(size_t entry) noexcept
+{
+    // The native code itself stays in the buffer until the next flush
+    for (size_t i{}; i < 2 * static_cast<size_t>(m_Length[entry]); i++)
+        m_CodeMap[(entry + i) & 0x0FFF]--;
+
+    m_Native[entry] = nullptr;
+    m_Length[entry] = 0;
+    m_Heat[entry] = 0;
+}
+
+// --- engine -----------------------------------------------------------------
+
+u32 RunJIT(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept
+{
+    u32 retired{};
+
+    // Fx0A always ends a block, so native code never has to check for a wait
+    while (retired < count && cpu.Wait != KeyWait::WAITING)
+    {
+        code.Sync(ram);
+
+        NativeBlock native = code.Native.Lookup(cpu.PC);
+        if (!native)
+        {
+            const Block& block = code.Blocks.Lookup(ram, cpu.PC);
+            if (code.Native.IsHot(cpu.PC))
+                native = code.Native.Compile(block);
+
+            if (!native)
+            {
+                retired += ExecuteBlock(cpu, ram, block, count - retired);
+                continue;
+            }
+        }
+
+        // Native code computes its flags eagerly
+        MaterializeFlag(cpu);
+
+        const u32 length = std::min(static_cast<u32>(code.Native.GetLength(cpu.PC)), count - retired);
+        native(&cpu, &ram, length);
+        retired += length;
+    }
+
+    return retired;
+}
+
+// --- code generation --------------------------------------------------------
+
+// Register usage inside a compiled block:
+//   rbx  CPUData*
+//   r14  RAM*
+//   r12d instructions left to execute
+//   r13d program counter on entry
+//   al, cl scratch
+static void EmitBlock(X64Emitter& emit, const Block& block, size_t& entry) noexcept
+{
+    // Instructions that are handed to their C++ executor need their operands
+    // somewhere in memory, so they are copied in front of the code
+    std::array<const void*, C8_MAX_BLOCK_LENGTH> data{};
+    for (size_t i{}; i < block.Length; i++)
+        data[i] = emit.EmitData(&block.Ops[i].op, sizeof(OpCode), alignof(OpCode));
+
+    emit.Align(16);
+    entry = emit.GetSize();
+
+    emit.Prologue();
+    emit.PinArguments();
+    emit.LoadR13W(OFFSET_PC);
+
+    std::array<size_t, C8_MAX_BLOCK_LENGTH> exits{};
+    size_t numExits{};
+
+    for (size_t i{}; i < block.Length; i++)
+    {
+        const bool last = i + 1 == block.Length;
+        if (last)
+        {
+            // Same as the block engine: the program counter is only written
+            // before the last instruction, which is the only one to read it
+            emit.MovEAXImm(static_cast<u32>(2 * block.Length));
+            emit.AddEAXR13();
+            emit.Store16(OFFSET_PC);
+        }
+
+        EmitOp(emit, block.Ops[i].op, data[i]);
+
+        if (!last)
+        {
+            emit.DecR12();
+            const size_t next = emit.Jne8();
+            emit.MovEAXImm(static_cast<u32>(2 * (i + 1)));
+            exits[numExits++] = emit.Jmp32();
+            emit.Bind8(next);
+        }
+    }
+
+    emit.Epilogue();
+
+    // Early exit when the instruction budget runs out mid-block, eax holds
+    // the number of bytes executed
+    const size_t exit = emit.GetSize();
+    emit.AddEAXR13();
+    emit.Store16(OFFSET_PC);
+    emit.Epilogue();
+
+    for (size_t i{}; i < numExits; i++)
+        emit.Bind32(exits[i], exit);
+}
+
+static void EmitOp(X64Emitter& emit, const OpCode& op, const void* data) noexcept
+{
+    constexpr i32 VF = V(0x0F);
+
+    switch (op.instr)
+    {
+        case Instr::JP_ADDR:
+            emit.Store16Imm(OFFSET_PC, op.nnn);
+            break;
+        case Instr::SE_VX_BYTE:
+        case Instr::SNE_VX_BYTE:
+        {
+            emit.Cmp8Imm(V(op.x), op.kk);
+            const size_t skip = op.instr == Instr::SE_VX_BYTE ? emit.Jne8() : emit.Je8();
+            emit.Add16Imm(OFFSET_PC, 2);
+            emit.Bind8(skip);
+        } break;
+        case Instr::SE_VX_VY:
+        case Instr::SNE_VX_VY:
+        {
+            emit.Load8(Reg8::AL, V(op.x));
+            emit.Load8(Reg8::CL, V(op.y));
+            emit.CmpALCL();
+            const size_t skip = op.instr == Instr::SE_VX_VY ? emit.Jne8() : emit.Je8();
+            emit.Add16Imm(OFFSET_PC, 2);
+            emit.Bind8(skip);
+        } break;
+        case Instr::LD_VX_BYTE:
+            emit.Store8Imm(V(op.x), op.kk);
+            break;
+        case Instr::LD_VX_VY:
+            emit.Load8(Reg8::AL, V(op.y));
+            emit.Store8(V(op.x), Reg8::AL);
+            break;
+        case Instr::LD_I_ADDR:
+            emit.Store16Imm(OFFSET_IDX, op.nnn);
+            break;
+        case Instr::LD_VX_DT:
+            emit.Load8(Reg8::AL, OFFSET_DT);
+            emit.Store8(V(op.x), Reg8::AL);
+            break;
+        case Instr::LD_DT_VX:
+            emit.Load8(Reg8::AL, V(op.x));
+            emit.Store8(OFFSET_DT, Reg8::AL);
+            break;
+        case Instr::LD_ST_VX:
+            emit.Load8(Reg8::AL, V(op.x));
+            emit.Store8(OFFSET_ST, Reg8::AL);
+            break;
+        case Instr::LD_FONT_VX:
+            emit.LoadZX8(V(op.x));
+            emit.MulEAX5();
+            emit.AddEAXImm(C8_ADDR_FONT);
+            emit.Store16(OFFSET_IDX);
+            break;
+        case Instr::ADD_VX_BYTE:
+            emit.Load8(Reg8::AL, V(op.x));
+            emit.AddALImm(op.kk);
+            emit.SetCCL();
+            emit.Store8(V(op.x), Reg8::AL);
+            emit.Store8(VF, Reg8::CL);
+            break;
+        case Instr::ADD_VX_VY:
+            emit.Load8(Reg8::AL, V(op.x));
+            emit.Load8(Reg8::CL, V(op.y));
+            emit.AddALCL();
+            emit.SetCCL();
+            emit.Store8(V(op.x), Reg8::AL);
+            emit.Store8(VF, Reg8::CL);
+            break;
+        case Instr::ADD_I_VX:
+            emit.LoadZX8(V(op.x));
+            emit.Add16(OFFSET_IDX);
+            break;
+        case Instr::OR_VX_VY:
+        case Instr::AND_VX_VY:
+        case Instr::XOR_VX_VY:
+        {
+            emit.Load8(Reg8::AL, V(op.x));
+            emit.Load8(Reg8::CL, V(op.y));
+            if (op.instr == Instr::OR_VX_VY)
+                emit.OrALCL();
+            else if (op.instr == Instr::AND_VX_VY)
+                emit.AndALCL();
+            else
+                emit.XorALCL();
+
+            emit.Store8(V(op.x), Reg8::AL);
+            emit.Store8Imm(VF, 0);
+        } break;
+        case Instr::SUB_VX_VY:
+        case Instr::SUBN_VX_VY:
+        {
+            const bool reverse = op.instr == Instr::SUBN_VX_VY;
+            emit.Load8(Reg8::AL, V(reverse ? op.y : op.x));
+            emit.Load8(Reg8::CL, V(reverse ? op.x : op.y));
+            emit.SubALCL();
+            emit.SetNCCL();
+            emit.Store8(V(op.x), Reg8::AL);
+            emit.Store8(VF, Reg8::CL);
+        } break;
+        case Instr::SHR_VX_VY:
+            emit.Load8(Reg8::AL, V(op.y));
+            emit.MovCLAL();
+            emit.AndCLImm(0x01);
+            emit.ShrAL();
+            emit.Store8(V(op.x), Reg8::AL);
+            emit.Store8(VF, Reg8::CL);
+            break;
+        case Instr::SHL_VX_VY:
+            emit.Load8(Reg8::AL, V(op.y));
+            emit.MovCLAL();
+            emit.ShrCLImm(7);
+            emit.ShlAL();
+            emit.Store8(V(op.x), Reg8::AL);
+            emit.Store8(VF, Reg8::CL);
+            break;
+        default:
+        {
+            // Everything else (DRW, RND, CALL, RET, Fx0A, memory access, ...)
+            // exits to the C++ executor
+            const ExecProc proc = C8_EXECUTORS[static_cast<size_t>(op.instr)];
+            emit.CallHelper(reinterpret_cast<const void*>(proc), data);
+        } break;
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "BlockCache.hpp"
+#include "CodeBuffer.hpp"
+#include "RAM.hpp"
+#include "Spec.hpp"
+
+#include <array>
+
+namespace c8emu {
+
+struct CPUData;
+struct CodeCache;
+
+using NativeBlock = void(*)(CPUData* cpu, RAM* ram, u32 count) noexcept;
+
+// Native translations of the blocks in the BlockCache, keyed by the same
+// entry addresses. Blocks are only compiled once they have been executed
+// C8_JIT_HOT_THRESHOLD times.
+class JitCache final
+{
+public:
+    constexpr JitCache() noexcept = default;
+
+    [[nodiscard]] constexpr NativeBlock Lookup(Address pc) const noexcept { return m_Native[static_cast<size_t>(pc & 0x0FFF)]; }
+    [[nodiscard]] constexpr u8 GetLength(Address pc) const noexcept { return m_Length[static_cast<size_t>(pc & 0x0FFF)]; }
+
+    [[nodiscard]] constexpr bool IsHot(Address pc) noexcept
+    {
+        u8& heat = m_Heat[static_cast<size_t>(pc & 0x0FFF)];
+        if (heat < C8_JIT_HOT_THRESHOLD)
+            heat++;
+
+        return heat >= C8_JIT_HOT_THRESHOLD;
+    }
+
+    [[nodiscard]] NativeBlock Compile(const Block& block) noexcept;
+    void Invalidate(DirtyRange range) noexcept;
+    void Clear() noexcept;
+
+private:
+    void Evict(size_t entry) noexcept;
+
+private:
+    using Entries = std::array<NativeBlock, C8_MEMORY_SIZE>;
+    using ByteMap = std::array<u8, C8_MEMORY_SIZE>;
+
+    CodeBuffer m_Buffer{};
+    Entries    m_Native{};
+    ByteMap    m_Length{};
+    ByteMap    m_Heat{};
+    ByteMap    m_CodeMap{}; // Number of compiled blocks covering each byte
+};
+
+u32 RunJIT(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept;
+
+}
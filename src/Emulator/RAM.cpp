@@ -9,6 +9,7 @@ void RAM::LoadROM(const ROM& rom) noexcept
 {
     const Buffer<Byte>& data = rom.GetData();
     std::memcpy(m_Buffer.data() + C8_ADDR_ROM, data.GetConstPtr(), rom.GetSize());
+    MarkDirty(C8_ADDR_ROM, static_cast<Address>(C8_ADDR_ROM + rom.GetSize()));
 }
 
 }
@@ -2,12 +2,23 @@
 
 #include "Spec.hpp"
 
+#include <algorithm>
 #include <array>
 
 namespace c8emu {
 
 class ROM;
 
+struct DirtyRange final
+{
+public:
+    Address Begin{};
+    Address End{};
+
+public:
+    [[nodiscard]] constexpr bool IsEmpty() const noexcept { return Begin >= End; }
+};
+
 class RAM final
 {
 public:
@@ -15,19 +26,43 @@ public:
 
     void LoadROM(const ROM& rom) noexcept;
 
-    [[nodiscard]] constexpr Byte& operator[](Address addr) noexcept
+    [[nodiscard]] constexpr const Byte& operator[](Address addr) const noexcept
     {
         addr &= 0x0FFF;
         return m_Buffer[static_cast<size_t>(addr)];
     }
 
-    [[nodiscard]] constexpr const Byte& operator[](Address addr) const noexcept
+    // All stores go through here so that any decoded code covering the
+    // address can be invalidated before it is executed again
+    constexpr void Write(Address addr, Byte value) noexcept
     {
         addr &= 0x0FFF;
-        return m_Buffer[static_cast<size_t>(addr)];
+        m_Buffer[static_cast<size_t>(addr)] = value;
+        MarkDirty(addr, addr + 1);
+    }
+
+    [[nodiscard]] constexpr bool IsDirty() const noexcept { return !m_Dirty.IsEmpty(); }
+
+    [[nodiscard]] constexpr DirtyRange TakeDirtyRange() noexcept
+    {
+        const DirtyRange range = m_Dirty;
+        m_Dirty = {};
+        return range;
     }
 
 private:
+    constexpr void MarkDirty(Address begin, Address end) noexcept
+    {
+        if (m_Dirty.IsEmpty())
+        {
+            m_Dirty = { begin, end };
+            return;
+        }
+
+        m_Dirty.Begin = std::min(m_Dirty.Begin, begin);
+        m_Dirty.End = std::max(m_Dirty.End, end);
+    }
+
     constexpr void LoadFont() noexcept
     {
         constexpr Byte fontset[C8_FONTSET_SIZE] = {
@@ -57,6 +92,7 @@ private:
     using MemoryBuffer = std::array<Byte, C8_MEMORY_SIZE>;
     
     MemoryBuffer m_Buffer{};
+    DirtyRange   m_Dirty{};
 };
 
 }
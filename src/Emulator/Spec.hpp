@@ -33,9 +33,30 @@ constexpr size_t C8_MAX_ROM_SIZE = C8_MEMORY_SIZE - C8_ADDR_ROM;
 
 constexpr size_t C8_CALLSTACK_SIZE = 32;
 
+// --- translation ------------------------------------------------------------
+
+constexpr size_t C8_MAX_BLOCK_LENGTH = 16;  // Maximum number of instructions per translated block
+constexpr size_t C8_BLOCK_CACHE_SIZE = 512; // Number of blocks kept before the cache is flushed
+
+constexpr size_t C8_JIT_BUFFER_SIZE   = 1024 * 1024; // Bytes of native code kept before the JIT is flushed
+constexpr u8     C8_JIT_HOT_THRESHOLD = 2;           // Executions of a block before it gets compiled
+
+constexpr u32 C8_TIER_TRANSLATE_THRESHOLD = 8;   // Executions of an entry before it runs as a block
+constexpr u32 C8_TIER_NATIVE_THRESHOLD    = 256; // Executions of an entry before it gets compiled
+
+// --- calibration ------------------------------------------------------------
+
+constexpr u32 C8_CALIBRATION_WARMUP       = 20'000;  // Instructions run by each engine before it is timed
+constexpr u32 C8_CALIBRATION_INSTRUCTIONS = 200'000; // Instructions timed for each engine
+
 // --- cycles -----------------------------------------------------------------
 
-constexpr u8 C8_OPS_PER_CYCLE = 8;
+constexpr u8 C8_OPS_PER_CYCLE = 8; // Default number of instructions run per frame
 constexpr float C8_TICK_RATE  = 1.0f / 60.0f;
 
+constexpr i32 C8_VIP_CYCLES_PER_FRAME = 3668; // Machine cycles of a 1.76 MHz COSMAC VIP per 60 Hz frame
+
+constexpr u32   C8_MAX_CATCH_UP_FRAMES = 4;      // Frames run at most per update to catch up, anything beyond is dropped
+constexpr float C8_TURBO_TIME_BUDGET   = 0.012f; // Host seconds spent emulating per update in turbo mode without a frame count
+
 }
@@ -0,0 +1,103 @@
+#include "Threaded.hpp"
+#include "Executors.hpp"
+
+#include "Core/Platform.hpp"
+
+namespace c8emu {
+
+#if defined(C8_HAS_COMPUTED_GOTO)
+
+// Label addresses and computed gotos are GNU extensions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+u32 RunThreaded(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept
+{
+#define C8_LABEL_ENTRY(instr, proc) &&L_##instr,
+    static const void* const s_Labels[] = {
+        C8_FOR_EACH_INSTR(C8_LABEL_ENTRY)
+    };
+#undef C8_LABEL_ENTRY
+
+    static_assert(std::size(s_Labels) == static_cast<size_t>(Instr::COUNT));
+
+    code.Sync(ram);
+
+    const u32 budget = count;
+    const OpCode* op{};
+
+    // Every handler ends with its own copy of the dispatch, so each one gets
+    // its own indirect jump (and branch history) instead of all of them
+    // funnelling through the same one at the top of a loop
+#define C8_DISPATCH()                                   \
+    do                                                  \
+    {                                                   \
+        if (count == 0)                                 \
+            return budget;                              \
+                                                        \
+        count--;                                        \
+        op = &code.Decoded.Fetch(ram, cpu.PC);          \
+        cpu.PC += 2;                                    \
+        goto *s_Labels[static_cast<size_t>(op->instr)]; \
+    } while (false)
+
+#define C8_HANDLER(instr, proc)                                                  \
+    L_##instr:                                                                   \
+    {                                                                            \
+        if (op->vf)                                                              \
+        {                                                                        \
+            MaterializeFlag(cpu);                                                \
+            proc(cpu, ram, *op);                                                 \
+        }                                                                        \
+        else if constexpr (ProducesFlag(Instr::instr))                           \
+        {                                                                        \
+            C8_LAZY_EXECUTORS[static_cast<size_t>(Instr::instr)](cpu, ram, *op); \
+        }                                                                        \
+        else                                                                     \
+        {                                                                        \
+            proc(cpu, ram, *op);                                                 \
+        }                                                                        \
+                                                                                 \
+        if constexpr (WritesMemory(Instr::instr))                                \
+            code.Sync(ram);                                                      \
+                                                                                 \
+        if constexpr (Instr::instr == Instr::LD_VX_KEY)                          \
+        {                                                                        \
+            if (cpu.Wait == KeyWait::WAITING)                                    \
+                return budget - count;                                           \
+        }                                                                        \
+                                                                                 \
+        C8_DISPATCH();                                                           \
+    }
+
+    C8_DISPATCH();
+    C8_FOR_EACH_INSTR(C8_HANDLER)
+
+#undef C8_HANDLER
+#undef C8_DISPATCH
+}
+
+#pragma GCC diagnostic pop
+
+#else
+
+u32 RunThreaded(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept
+{
+    u32 retired{};
+    while (retired < count && cpu.Wait != KeyWait::WAITING)
+    {
+        code.Sync(ram);
+
+        const OpCode& op = code.Decoded.Fetch(ram, cpu.PC);
+        cpu.PC += 2;
+
+        SelectExecutor(op)(cpu, ram, op);
+        retired++;
+    }
+
+    return retired;
+}
+
+#endif
+
+}
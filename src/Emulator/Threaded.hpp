@@ -0,0 +1,11 @@
+#pragma once
+
+#include "CPU.hpp"
+#include "CodeCache.hpp"
+#include "RAM.hpp"
+
+namespace c8emu {
+
+u32 RunThreaded(CPUData& cpu, RAM& ram, CodeCache& code, u32 count) noexcept;
+
+}
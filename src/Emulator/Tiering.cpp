@@ -0,0 +1,92 @@
+#include "Tiering.hpp"
+#include "Blocks.hpp"
+#include "CPU.hpp"
+#include "CodeCache.hpp"
+#include "Executors.hpp"
+
+namespace c8emu {
+
+void TierManager::Invalidate(DirtyRange range) noexcept
+{
+    // Only entries up to one maximal block before the range can reach into it
+    constexpr size_t reach = 2 * C8_MAX_BLOCK_LENGTH;
+    const size_t begin = range.Begin > reach ? range.Begin - reach : 0;
+
+    for (size_t entry = begin; entry < range.End && entry < C8_MEMORY_SIZE; entry++)
+    {
+        Tier& tier = m_Tier[entry];
+        if (tier == Tier::INTERPRETED)
+            continue;
+
+        const size_t end = entry + 2 * static_cast<size_t>(m_Span[entry]);
+        if (end <= range.Begin)
+            continue;
+
+        m_Stats.Entries[static_cast<size_t>(tier)]--;
+        m_Stats.Entries[static_cast<size_t>(Tier::INTERPRETED)]++;
+        m_Stats.Demotions++;
+
+        tier = Tier::INTERPRETED;
+        m_Heat[entry] = 1;
+    }
+}
+
+u32 RunTiered(CPUData& cpu, RAM& ram, CodeCache& code, TierManager& tiers, u32 count) noexcept
+{
+    u32 total{};
+    while (total < count && cpu.Wait != KeyWait::WAITING)
+    {
+        const DirtyRange range = code.Sync(ram);
+        if (!range.IsEmpty())
+            tiers.Invalidate(range);
+
+        const Address pc = cpu.PC;
+        const Tier tier = tiers.Enter(pc);
+
+        u32 retired{};
+        u8 span = 1;
+        switch (tier)
+        {
+            case Tier::INTERPRETED:
+            {
+                const OpCode& opcode = code.Decoded.Fetch(ram, pc);
+                cpu.PC += 2;
+
+                SelectExecutor(opcode)(cpu, ram, opcode);
+                retired = 1;
+            } break;
+#if defined(C8_JIT)
+            case Tier::NATIVE:
+            {
+                NativeBlock native = code.Native.Lookup(pc);
+                if (!native)
+                    native = code.Native.Compile(code.Blocks.Lookup(ram, pc));
+
+                if (native)
+                {
+                    // Native code computes its flags eagerly
+                    MaterializeFlag(cpu);
+
+                    span = code.Native.GetLength(pc);
+                    retired = std::min(static_cast<u32>(span), count - total);
+                    native(&cpu, &ram, retired);
+                    break;
+                }
+            } [[fallthrough]];
+#endif
+            default:
+            {
+                const Block& block = code.Blocks.Lookup(ram, pc);
+                span = block.GetSpan();
+                retired = ExecuteBlock(cpu, ram, block, count - total);
+            } break;
+        }
+
+        tiers.Retire(pc, tier, retired, span);
+        total += retired;
+    }
+
+    return total;
+}
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "RAM.hpp"
+#include "Spec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string_view>
+
+namespace c8emu {
+
+// Forward declerations
+struct CPUData;
+struct CodeCache;
+
+enum class Tier : u8
+{
+    INTERPRETED,
+    TRANSLATED,
+    NATIVE,
+
+    COUNT
+};
+
+constexpr size_t C8_NUM_TIERS = static_cast<size_t>(Tier::COUNT);
+
+#if defined(C8_JIT)
+constexpr Tier C8_MAX_TIER = Tier::NATIVE;
+#else
+constexpr Tier C8_MAX_TIER = Tier::TRANSLATED;
+#endif
+
+[[nodiscard]] constexpr std::string_view GetTierName(Tier tier) noexcept
+{
+    switch (tier)
+    {
+        case Tier::INTERPRETED: return "interpreted";
+        case Tier::TRANSLATED:  return "translated";
+        case Tier::NATIVE:      return "native";
+        default:                return "unknown";
+    }
+}
+
+struct TierThresholds final
+{
+public:
+    u32 Translated{C8_TIER_TRANSLATE_THRESHOLD};
+    u32 Native{C8_TIER_NATIVE_THRESHOLD};
+};
+
+struct TierStats final
+{
+public:
+    using Counters = std::array<u64, C8_NUM_TIERS>;
+
+    Counters Entries{};    // Entry points currently in each tier
+    Counters Promotions{}; // Entry points promoted into each tier
+    Counters Retired{};    // Instructions retired in each tier
+    u64      Demotions{};
+};
+
+// Counts how often execution enters each address and decides which engine
+// runs it. Everything starts interpreted and moves up a tier once its
+// counter passes the threshold. Overwritten code drops back to the bottom.
+class TierManager final
+{
+public:
+    constexpr TierManager() noexcept = default;
+
+    constexpr void SetThresholds(TierThresholds thresholds) noexcept { m_Thresholds = thresholds; }
+
+    [[nodiscard]] constexpr Tier Enter(Address pc) noexcept
+    {
+        const size_t entry = static_cast<size_t>(pc & 0x0FFF);
+
+        u32& heat = m_Heat[entry];
+        if (heat == 0)
+            m_Stats.Entries[static_cast<size_t>(Tier::INTERPRETED)]++;
+
+        if (heat < std::numeric_limits<u32>::max())
+            heat++;
+
+        Tier next = Tier::INTERPRETED;
+        if (heat >= m_Thresholds.Native)
+            next = Tier::NATIVE;
+        else if (heat >= m_Thresholds.Translated)
+            next = Tier::TRANSLATED;
+
+        next = std::min(next, C8_MAX_TIER);
+
+        Tier& tier = m_Tier[entry];
+        if (next > tier)
+        {
+            m_Stats.Entries[static_cast<size_t>(tier)]--;
+            m_Stats.Entries[static_cast<size_t>(next)]++;
+            m_Stats.Promotions[static_cast<size_t>(next)]++;
+            tier = next;
+        }
+
+        return tier;
+    }
+
+    // Records how many instructions were run from `pc` and how far they reach
+    constexpr void Retire(Address pc, Tier tier, u32 count, u8 span) noexcept
+    {
+        m_Span[static_cast<size_t>(pc & 0x0FFF)] = span;
+        m_Stats.Retired[static_cast<size_t>(tier)] += count;
+    }
+
+    void Invalidate(DirtyRange range) noexcept;
+
+    [[nodiscard]] constexpr const TierStats& GetStats() const noexcept { return m_Stats; }
+    [[nodiscard]] constexpr TierThresholds GetThresholds() const noexcept { return m_Thresholds; }
+
+private:
+    using HeatMap = std::array<u32, C8_MEMORY_SIZE>;
+    using TierMap = std::array<Tier, C8_MEMORY_SIZE>;
+    using SpanMap = std::array<u8, C8_MEMORY_SIZE>;
+
+    HeatMap        m_Heat{};
+    TierMap        m_Tier{};
+    SpanMap        m_Span{}; // Instructions covered by the last run from each entry
+    TierStats      m_Stats{};
+    TierThresholds m_Thresholds{};
+};
+
+u32 RunTiered(CPUData& cpu, RAM& ram, CodeCache& code, TierManager& tiers, u32 count) noexcept;
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Instructions.hpp"
+
+#include <optional>
+#include <string_view>
+
+namespace c8emu {
+
+enum class TimingModel : u8
+{
+    FIXED, // A fixed number of instructions per frame
+    VIP,   // Each instruction costs what it did on the COSMAC VIP
+};
+
+[[nodiscard]] constexpr std::string_view GetTimingName(TimingModel timing) noexcept
+{
+    return timing == TimingModel::VIP ? "vip" : "fixed";
+}
+
+[[nodiscard]] constexpr std::optional<TimingModel> ParseTimingModel(std::string_view name) noexcept
+{
+    if (name == "fixed")
+        return TimingModel::FIXED;
+    if (name == "vip")
+        return TimingModel::VIP;
+
+    return std::nullopt;
+}
+
+// Approximate cost of each instruction in machine cycles of the original
+// COSMAC VIP interpreter. Taken skips are a few cycles more expensive there,
+// which is not modelled, and neither is the time DRW spends waiting for the
+// display interrupt (see WaitsForDisplay).
+[[nodiscard]] constexpr u16 GetVIPCycles(const OpCode& op) noexcept
+{
+    switch (op.instr)
+    {
+        case Instr::RAW:          return 10;
+        case Instr::CLS:          return 3078;
+        case Instr::RET:          return 10;
+        case Instr::JP_ADDR:      return 12;
+        case Instr::JP_V0_ADDR:   return 22;
+        case Instr::CALL_ADDR:    return 26;
+        case Instr::SE_VX_BYTE:   return 10;
+        case Instr::SE_VX_VY:     return 14;
+        case Instr::SNE_VX_BYTE:  return 10;
+        case Instr::SNE_VX_VY:    return 14;
+        case Instr::LD_VX_BYTE:   return 6;
+        case Instr::LD_VX_VY:     return 12;
+        case Instr::LD_I_ADDR:    return 12;
+        case Instr::LD_VX_DT:     return 10;
+        case Instr::LD_VX_KEY:    return 10;
+        case Instr::LD_DT_VX:     return 10;
+        case Instr::LD_ST_VX:     return 10;
+        case Instr::LD_FONT_VX:   return 16;
+        case Instr::LD_BCD_VX:    return 84;
+        case Instr::LD_ADDR_I_VX:
+        case Instr::LD_VX_ADDR_I: return static_cast<u16>(14 + 14 * (op.x + 1));
+        case Instr::ADD_VX_BYTE:  return 10;
+        case Instr::ADD_I_VX:     return 16;
+        case Instr::RND_VX_BYTE:  return 36;
+        case Instr::DRW_VX_VY_N:  return static_cast<u16>(26 + 72 * op.n);
+        case Instr::SKP_VX:       return 14;
+        case Instr::SKNP_VX:      return 14;
+        default:                  return 44; // The 8xyN arithmetic
+    }
+}
+
+// On the VIP a sprite is only drawn once the display interrupt has fired,
+// which leaves the rest of the frame to the display
+[[nodiscard]] constexpr bool WaitsForDisplay(Instr instr) noexcept
+{
+    return instr == Instr::DRW_VX_VY_N;
+}
+
+}
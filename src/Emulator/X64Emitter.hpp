@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Core/Types.hpp"
+
+#include <cstring>
+#include <initializer_list>
+
+namespace c8emu {
+
+// The handful of 8-bit registers used by the JIT, numbered as in ModR/M
+enum class Reg8 : u8
+{
+    AL = 0,
+    CL = 1,
+};
+
+// Minimal x86-64 encoder for the instructions emitted by the JIT. Every
+// memory operand is addressed relative to rbx, which holds the CPUData
+// pointer for the whole lifetime of a compiled block.
+class X64Emitter final
+{
+public:
+    constexpr X64Emitter(u8* begin, size_t capacity) noexcept :
+        m_Begin(begin), m_Capacity(capacity) {}
+
+    [[nodiscard]] constexpr size_t GetSize() const noexcept { return m_Size; }
+    [[nodiscard]] constexpr bool HasOverflowed() const noexcept { return m_Overflowed; }
+
+    // --- prologue/epilogue --------------------------------------------------
+
+    // push rbx, rbp, r12, r13, r14 (leaves the stack 16-byte aligned)
+    inline void Prologue() noexcept { Emit({ 0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56 }); }
+    // pop r14, r13, r12, rbp, rbx; ret
+    inline void Epilogue() noexcept { Emit({ 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D, 0x5B, 0xC3 }); }
+
+    // mov rbx, rdi; mov r14, rsi; mov r12d, edx
+    inline void PinArguments() noexcept { Emit({ 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF6, 0x41, 0x89, 0xD4 }); }
+
+    // movzx r13d, word [rbx + disp]
+    inline void LoadR13W(i32 disp) noexcept { Emit({ 0x44, 0x0F, 0xB7, 0xAB }); Emit32(disp); }
+
+    // --- 8-bit register/memory ----------------------------------------------
+
+    // mov r8, byte [rbx + disp]
+    inline void Load8(Reg8 reg, i32 disp) noexcept { Emit({ 0x8A, ModRMDisp(reg) }); Emit32(disp); }
+    // mov byte [rbx + disp], r8
+    inline void Store8(i32 disp, Reg8 reg) noexcept { Emit({ 0x88, ModRMDisp(reg) }); Emit32(disp); }
+    // mov byte [rbx + disp], imm8
+    inline void Store8Imm(i32 disp, u8 imm) noexcept { Emit({ 0xC6, 0x83 }); Emit32(disp); Emit({ imm }); }
+    // cmp byte [rbx + disp], imm8
+    inline void Cmp8Imm(i32 disp, u8 imm) noexcept { Emit({ 0x80, 0xBB }); Emit32(disp); Emit({ imm }); }
+
+    inline void AddALImm(u8 imm) noexcept { Emit({ 0x04, imm }); } // add al, imm8
+    inline void AddALCL() noexcept { Emit({ 0x00, 0xC8 }); }       // add al, cl
+    inline void SubALCL() noexcept { Emit({ 0x28, 0xC8 }); }       // sub al, cl
+    inline void OrALCL() noexcept { Emit({ 0x08, 0xC8 }); }        // or al, cl
+    inline void AndALCL() noexcept { Emit({ 0x20, 0xC8 }); }       // and al, cl
+    inline void XorALCL() noexcept { Emit({ 0x30, 0xC8 }); }       // xor al, cl
+    inline void CmpALCL() noexcept { Emit({ 0x38, 0xC8 }); }       // cmp al, cl
+    inline void ShrAL() noexcept { Emit({ 0xD0, 0xE8 }); }         // shr al, 1
+    inline void ShlAL() noexcept { Emit({ 0xD0, 0xE0 }); }         // shl al, 1
+    inline void MovCLAL() noexcept { Emit({ 0x88, 0xC1 }); }       // mov cl, al
+    inline void AndCLImm(u8 imm) noexcept { Emit({ 0x80, 0xE1, imm }); } // and cl, imm8
+    inline void ShrCLImm(u8 imm) noexcept { Emit({ 0xC0, 0xE9, imm }); } // shr cl, imm8
+    inline void SetCCL() noexcept { Emit({ 0x0F, 0x92, 0xC1 }); }  // setc cl
+    inline void SetNCCL() noexcept { Emit({ 0x0F, 0x93, 0xC1 }); } // setnc cl
+
+    // --- 16/32-bit ----------------------------------------------------------
+
+    // movzx eax, byte [rbx + disp]
+    inline void LoadZX8(i32 disp) noexcept { Emit({ 0x0F, 0xB6, 0x83 }); Emit32(disp); }
+    // mov word [rbx + disp], ax
+    inline void Store16(i32 disp) noexcept { Emit({ 0x66, 0x89, 0x83 }); Emit32(disp); }
+    // mov word [rbx + disp], imm16
+    inline void Store16Imm(i32 disp, u16 imm) noexcept { Emit({ 0x66, 0xC7, 0x83 }); Emit32(disp); Emit16(imm); }
+    // add word [rbx + disp], ax
+    inline void Add16(i32 disp) noexcept { Emit({ 0x66, 0x01, 0x83 }); Emit32(disp); }
+    // add word [rbx + disp], imm8
+    inline void Add16Imm(i32 disp, u8 imm) noexcept { Emit({ 0x66, 0x83, 0x83 }); Emit32(disp); Emit({ imm }); }
+    // lea eax, [rax + rax * 4]
+    inline void MulEAX5() noexcept { Emit({ 0x8D, 0x04, 0x80 }); }
+    // mov eax, imm32
+    inline void MovEAXImm(u32 imm) noexcept { Emit({ 0xB8 }); Emit32(static_cast<i32>(imm)); }
+    // add eax, imm32
+    inline void AddEAXImm(u32 imm) noexcept { Emit({ 0x05 }); Emit32(static_cast<i32>(imm)); }
+    // add eax, r13d
+    inline void AddEAXR13() noexcept { Emit({ 0x44, 0x01, 0xE8 }); }
+    // dec r12d
+    inline void DecR12() noexcept { Emit({ 0x41, 0xFF, 0xCC }); }
+
+    // --- calls --------------------------------------------------------------
+
+    // mov rdi, rbx; mov rsi, r14; mov rdx, imm64; mov rax, imm64; call rax
+    inline void CallHelper(const void* proc, const void* arg) noexcept
+    {
+        Emit({ 0x48, 0x89, 0xDF, 0x4C, 0x89, 0xF6, 0x48, 0xBA });
+        Emit64(reinterpret_cast<u64>(arg));
+        Emit({ 0x48, 0xB8 });
+        Emit64(reinterpret_cast<u64>(proc));
+        Emit({ 0xFF, 0xD0 });
+    }
+
+    // --- branches -----------------------------------------------------------
+
+    // jne rel8/je rel8, returns the offset of the displacement
+    [[nodiscard]] inline size_t Jne8() noexcept { Emit({ 0x75, 0x00 }); return m_Size - 1; }
+    [[nodiscard]] inline size_t Je8() noexcept { Emit({ 0x74, 0x00 }); return m_Size - 1; }
+    // jmp rel32, returns the offset of the displacement
+    [[nodiscard]] inline size_t Jmp32() noexcept { Emit({ 0xE9 }); Emit32(0); return m_Size - 4; }
+
+    // Points a previously emitted branch at the current position
+    inline void Bind8(size_t at) noexcept
+    {
+        if (!m_Overflowed)
+            m_Begin[at] = static_cast<u8>(m_Size - (at + 1));
+    }
+
+    inline void Bind32(size_t at, size_t target) noexcept
+    {
+        if (m_Overflowed)
+            return;
+
+        const i32 rel = static_cast<i32>(target) - static_cast<i32>(at + 4);
+        std::memcpy(m_Begin + at, &rel, sizeof(rel));
+    }
+
+    // --- data ---------------------------------------------------------------
+
+    // Pads the stream with int3 up to a multiple of `alignment`
+    inline void Align(size_t alignment) noexcept
+    {
+        while (m_Size % alignment && !m_Overflowed)
+            Emit({ 0xCC });
+    }
+
+    // Copies raw bytes into the stream aligned to `alignment` and returns their
+    // address
+    [[nodiscard]] inline const void* EmitData(const void* data, size_t size, size_t alignment) noexcept
+    {
+        Align(alignment);
+
+        const u8* addr = m_Begin + m_Size;
+        if (m_Size + size > m_Capacity)
+        {
+            m_Overflowed = true;
+            return addr;
+        }
+
+        std::memcpy(m_Begin + m_Size, data, size);
+        m_Size += size;
+        return addr;
+    }
+
+private:
+    // ModR/M byte for [rbx + disp32] with `reg` in the reg field
+    static constexpr u8 ModRMDisp(Reg8 reg) noexcept { return static_cast<u8>(0x83 | (static_cast<u8>(reg) << 3)); }
+
+    inline void Emit(std::initializer_list<u8> bytes) noexcept
+    {
+        if (m_Size + bytes.size() > m_Capacity)
+        {
+            m_Overflowed = true;
+            return;
+        }
+
+        for (const u8 byte : bytes)
+            m_Begin[m_Size++] = byte;
+    }
+
+    inline void Emit16(u16 value) noexcept { Emit({ static_cast<u8>(value), static_cast<u8>(value >> 8) }); }
+    inline void Emit32(i32 value) noexcept
+    {
+        const u32 v = static_cast<u32>(value);
+        Emit({ static_cast<u8>(v), static_cast<u8>(v >> 8), static_cast<u8>(v >> 16), static_cast<u8>(v >> 24) });
+    }
+    inline void Emit64(u64 value) noexcept
+    {
+        Emit32(static_cast<i32>(value & 0xFFFFFFFF));
+        Emit32(static_cast<i32>(value >> 32));
+    }
+
+private:
+    u8*    m_Begin{};
+    size_t m_Capacity{};
+    size_t m_Size{};
+    bool   m_Overflowed{};
+};
+
+}
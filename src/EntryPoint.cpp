@@ -1,4 +1,6 @@
 #include "Client/Client.hpp"
+#include "Client/Headless.hpp"
+#include "Client/Options.hpp"
 #include "Core/Platform.hpp"
 
 #if defined(C8_PLATFORM_WINDOWS) && defined(C8_RELEASE)
@@ -6,7 +8,11 @@
 
 int WINAPI WinMain(UNUSED HINSTANCE hInstance, UNUSED HINSTANCE hPrevInstance, UNUSED LPSTR lpCmdLine, UNUSED int nShowCmd)
 {
-    c8emu::Client client(__argc, __argv);
+    const c8emu::Options options = c8emu::Options::Parse(__argc, __argv);
+    if (options.Headless)
+        return c8emu::RunHeadless(options);
+
+    c8emu::Client client(options);
     client.Run();
     return 0;
 }
@@ -14,7 +20,11 @@ int WINAPI WinMain(UNUSED HINSTANCE hInstance, UNUSED HINSTANCE hPrevInstance, U
 #else
 int main(int argc, char** argv)
 {
-    c8emu::Client client(argc, argv);
+    const c8emu::Options options = c8emu::Options::Parse(argc, argv);
+    if (options.Headless)
+        return c8emu::RunHeadless(options);
+
+    c8emu::Client client(options);
     client.Run();
 }
 #endif
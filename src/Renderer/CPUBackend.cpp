@@ -0,0 +1,177 @@
+#include "CPUBackend.hpp"
+
+#include "Core/Platform.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace c8emu {
+
+[[nodiscard]] static constexpr bool IsLit(Color color) noexcept
+{
+    const u32 luma = (77 * static_cast<u32>(color.R) + 150 * static_cast<u32>(color.G) + 29 * static_cast<u32>(color.B)) >> 8;
+    return luma >= 128;
+}
+
+[[nodiscard]] static constexpr u8 Blend(u8 src, u8 dst, u8 alpha) noexcept
+{
+    return static_cast<u8>((static_cast<u32>(src) * alpha + static_cast<u32>(dst) * (255 - alpha)) / 255);
+}
+
+CPUBackend::CPUBackend(u32 width, u32 height, PixelFormat format) noexcept :
+    m_Format(format)
+{
+    OnResize(width, height);
+}
+
+void CPUBackend::Begin() noexcept
+{
+    FillRect(0, 0, static_cast<i32>(m_Width), static_cast<i32>(m_Height), m_Palette[0]);
+}
+
+void CPUBackend::DrawBuffer(const u64* rows, size_t width, size_t height, UNUSED u32 dirtyRows) noexcept
+{
+    if (width == 0 || height == 0)
+        return;
+
+    // Whole pixels only, centred in whatever is left over
+    const i32 scale = std::max(1, static_cast<i32>(std::min(m_Width / width, m_Height / height)));
+    const i32 left = (static_cast<i32>(m_Width) - static_cast<i32>(width) * scale) / 2;
+    const i32 top = (static_cast<i32>(m_Height) - static_cast<i32>(height) * scale) / 2;
+
+    // Begin() already cleared the whole image, unchanged rows included, so
+    // every lit pixel is drawn again
+    for (size_t y{}; y < height; y++)
+    {
+        u64 row = rows[y];
+        for (size_t x{}; row != 0; x++, row <<= 1)
+            if (row >> 63)
+                FillRect(left + static_cast<i32>(x) * scale, top + static_cast<i32>(y) * scale, scale, scale, m_Palette[1]);
+    }
+}
+
+void CPUBackend::End(const DebugOverlay& overlay) noexcept
+{
+    // The image is composed from scratch every frame, so the quads are too
+    LayoutDebugOverlay(overlay, m_Quads);
+    for (const AtlasQuad& quad : m_Quads)
+        DrawQuad(quad);
+}
+
+void CPUBackend::OnResize(u32 width, u32 height) noexcept
+{
+    m_Width = width;
+    m_Height = height;
+    m_Stride = m_Format == PixelFormat::MONO1 ? (static_cast<size_t>(width) + 7) / 8 : static_cast<size_t>(width) * 4;
+    m_Pixels.assign(m_Stride * static_cast<size_t>(height), 0);
+}
+
+BackendID CPUBackend::GetID() const noexcept
+{
+    return m_Format == PixelFormat::MONO1 ? BackendID::CPU_MONO : BackendID::CPU;
+}
+
+void CPUBackend::FillRect(i32 x, i32 y, i32 width, i32 height, Color color) noexcept
+{
+    const i32 x0 = std::max(x, 0);
+    const i32 y0 = std::max(y, 0);
+    const i32 x1 = std::min(x + width, static_cast<i32>(m_Width));
+    const i32 y1 = std::min(y + height, static_cast<i32>(m_Height));
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    const size_t count = static_cast<size_t>(x1 - x0);
+    for (i32 py = y0; py < y1; py++)
+    {
+        u8* row = m_Pixels.data() + static_cast<size_t>(py) * m_Stride;
+        if (m_Format == PixelFormat::MONO1)
+            FillMonoSpan(row, static_cast<size_t>(x0), count, IsLit(color));
+        else
+            FillRGBASpan(row + static_cast<size_t>(x0) * 4, count, color);
+    }
+}
+
+void CPUBackend::DrawQuad(const AtlasQuad& quad) noexcept
+{
+    constexpr u32 CELL_SIZE = GlyphAtlas::CELL_SIZE;
+
+    if (quad.Cell == GlyphAtlas::SOLID_CELL)
+    {
+        FillRect(quad.X, quad.Y, quad.Width, quad.Height, quad.Tint);
+        return;
+    }
+
+    // Nearest texel, with every run of lit texels in a row filled at once
+    const i32 scaleX = quad.Width / static_cast<i32>(CELL_SIZE);
+    const i32 scaleY = quad.Height / static_cast<i32>(CELL_SIZE);
+    const u32 u0 = GlyphAtlas::GetCellX(quad.Cell);
+    const u32 v0 = GlyphAtlas::GetCellY(quad.Cell);
+    for (u32 v{}; v < CELL_SIZE; v++)
+    {
+        const i32 y = quad.Y + static_cast<i32>(v) * scaleY;
+        for (u32 u{}; u < CELL_SIZE;)
+        {
+            if (!C8_GLYPH_ATLAS.GetTexel(u0 + u, v0 + v))
+            {
+                u++;
+                continue;
+            }
+
+            const u32 first = u;
+            while (u < CELL_SIZE && C8_GLYPH_ATLAS.GetTexel(u0 + u, v0 + v))
+                u++;
+
+            FillRect(quad.X + static_cast<i32>(first) * scaleX, y, static_cast<i32>(u - first) * scaleX, scaleY, quad.Tint);
+        }
+    }
+}
+
+void CPUBackend::FillMonoSpan(u8* row, size_t x, size_t count, bool lit) noexcept
+{
+    // Partial bytes at either end, whole bytes in between
+    const size_t end = x + count;
+    while (x < end && x % 8)
+    {
+        const u8 mask = static_cast<u8>(0x80 >> (x % 8));
+        row[x / 8] = lit ? static_cast<u8>(row[x / 8] | mask) : static_cast<u8>(row[x / 8] & ~mask);
+        x++;
+    }
+
+    const size_t bytes = (end - x) / 8;
+    std::memset(row + x / 8, lit ? 0xFF : 0x00, bytes);
+    x += bytes * 8;
+
+    for (; x < end; x++)
+    {
+        const u8 mask = static_cast<u8>(0x80 >> (x % 8));
+        row[x / 8] = lit ? static_cast<u8>(row[x / 8] | mask) : static_cast<u8>(row[x / 8] & ~mask);
+    }
+}
+
+void CPUBackend::FillRGBASpan(u8* pixels, size_t count, Color color) noexcept
+{
+    if (color.A == 255)
+    {
+        const u8 rgba[4] = { color.R, color.G, color.B, 255 };
+        for (size_t i{}; i < count; i++)
+            std::memcpy(pixels + i * 4, rgba, sizeof(rgba));
+
+        return;
+    }
+
+    for (size_t i{}; i < count; i++)
+    {
+        u8* pixel = pixels + i * 4;
+        pixel[0] = Blend(color.R, pixel[0], color.A);
+        pixel[1] = Blend(color.G, pixel[1], color.A);
+        pixel[2] = Blend(color.B, pixel[2], color.A);
+        pixel[3] = 255;
+    }
+}
+
+std::unique_ptr<CPUBackend> CreateCPUBackend(u32 width, u32 height, PixelFormat format) noexcept
+{
+    return std::make_unique<CPUBackend>(width, height, format);
+}
+
+}
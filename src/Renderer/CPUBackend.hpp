@@ -0,0 +1,58 @@
+#pragma once
+
+#include "GlyphAtlas.hpp"
+#include "RenderBackend.hpp"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace c8emu {
+
+enum class PixelFormat : u8
+{
+    RGBA8, // Four bytes per pixel
+    MONO1, // One bit per pixel, the leftmost pixel in the most significant bit
+};
+
+// Renders into memory, so that the whole render path can run without a
+// display. Overlay text is drawn from the same glyph atlas as on the GPU.
+class CPUBackend final : public RenderBackend
+{
+public:
+    CPUBackend(u32 width, u32 height, PixelFormat format) noexcept;
+
+    void Begin() noexcept override;
+    void DrawBuffer(const u64* rows, size_t width, size_t height, u32 dirtyRows) noexcept override;
+    void End(const DebugOverlay& overlay) noexcept override;
+
+    void OnResize(u32 width, u32 height) noexcept override;
+
+    [[nodiscard]] BackendID GetID() const noexcept override;
+
+    [[nodiscard]] inline std::span<const u8> GetPixels() const noexcept { return m_Pixels; }
+    [[nodiscard]] constexpr u32 GetWidth() const noexcept { return m_Width; }
+    [[nodiscard]] constexpr u32 GetHeight() const noexcept { return m_Height; }
+    [[nodiscard]] constexpr size_t GetStride() const noexcept { return m_Stride; }
+    [[nodiscard]] constexpr PixelFormat GetFormat() const noexcept { return m_Format; }
+
+private:
+    // Rectangles are clipped to the image and blended in RGBA8. MONO1 lights
+    // a pixel for any colour brighter than half.
+    void FillRect(i32 x, i32 y, i32 width, i32 height, Color color) noexcept;
+    void DrawQuad(const AtlasQuad& quad) noexcept;
+    static void FillMonoSpan(u8* row, size_t x, size_t count, bool lit) noexcept;
+    static void FillRGBASpan(u8* pixels, size_t count, Color color) noexcept;
+
+private:
+    std::vector<u8>        m_Pixels{};
+    std::vector<AtlasQuad> m_Quads{};
+    size_t                 m_Stride{};
+    u32                    m_Width{};
+    u32                    m_Height{};
+    PixelFormat            m_Format{};
+};
+
+[[nodiscard]] std::unique_ptr<CPUBackend> CreateCPUBackend(u32 width, u32 height, PixelFormat format) noexcept;
+
+}
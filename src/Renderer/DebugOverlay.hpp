@@ -1,27 +1,47 @@
 #pragma once
 
-#include <SFML/System/Vector2.hpp>
-#include <SFML/System/String.hpp>
-
+#include <cstddef>
 #include <format>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace c8emu {
 
-constexpr sf::Vector2f INIT_POSITION = { 5.0f, 5.0f };
+struct Vec2f final
+{
+public:
+    float X{};
+    float Y{};
+};
+
+constexpr Vec2f INIT_POSITION = { 5.0f, 5.0f };
 
 struct DebugText final
 {
 public:
-    sf::String   Text{};
-    sf::Vector2f Position{};
+    static constexpr size_t MAX_LENGTH = 128;
+
+public:
+    std::string Text{};
+    Vec2f       Position{};
+    bool        Changed{}; // Since the last frame presented
 
 public:
-    constexpr DebugText(sf::String&& text, sf::Vector2f position) noexcept :
-        Text(text),
-        Position(position) {}
+    // Room for the longest line up front, so rewriting it never allocates
+    inline DebugText(std::string_view text, Vec2f position) noexcept :
+        Position(position),
+        Changed(true)
+    {
+        Text.reserve(MAX_LENGTH);
+        Text.assign(text);
+    }
 };
 
+// Lines are kept from one refresh to the next and only rewritten when their
+// text differs, so backends can hold on to whatever they built from a line
+// until it changes. Lines that go away keep their storage for later, so a
+// refresh never allocates once every line has been seen.
 class DebugOverlay final
 {
 public:
@@ -29,6 +49,10 @@ public:
     static constexpr T FONT_SIZE = static_cast<T>(16);
     template<typename T>
     static constexpr T FONT_SPACING = static_cast<T>(8);
+    template<typename T>
+    static constexpr T PADDING = static_cast<T>(5);
+
+    static constexpr float DEFAULT_REFRESH_RATE = 4.0f; // Hz
 
     using ConstIter = std::vector<DebugText>::const_iterator;
     using Iter = std::vector<DebugText>::iterator;
@@ -39,37 +63,88 @@ public:
 public:
     constexpr DebugOverlay() noexcept = default;
 
-    constexpr void Clear() noexcept
+    // Lines appended after this replace the current ones in order
+    constexpr void BeginRefresh() noexcept
     {
-        m_Buffer.clear();
+        m_Next = 0;
         m_NextPosition = INIT_POSITION;
     }
 
+    // Drops whatever lines the refresh did not get to
+    constexpr void EndRefresh() noexcept
+    {
+        m_Changed |= m_Next != m_Size;
+        m_Size = m_Next;
+    }
+
+    constexpr void Clear() noexcept
+    {
+        m_Changed |= m_Size > 0;
+        m_Size = 0;
+        BeginRefresh();
+    }
+
     template<typename ... Args>
     constexpr void Append(std::format_string<Args...> fmt, Args&& ... args) noexcept
     {
-        m_Buffer.emplace_back(std::format(fmt, std::forward<Args>(args)...), m_NextPosition);
-        m_NextPosition.y += FONT_SIZE<float> + FONT_SPACING<float>;
+        char buffer[DebugText::MAX_LENGTH];
+        const auto result = std::format_to_n(buffer, DebugText::MAX_LENGTH, fmt, std::forward<Args>(args)...);
+        const std::string_view text(buffer, static_cast<size_t>(result.out - buffer));
+
+        if (m_Next == m_Buffer.size())
+        {
+            m_Buffer.emplace_back(text, m_NextPosition);
+            m_Changed = true;
+        }
+        else if (DebugText& line = m_Buffer[m_Next]; m_Next >= m_Size || line.Text != text)
+        {
+            line.Text.assign(text);
+            line.Position = m_NextPosition;
+            line.Changed = true;
+            m_Changed = true;
+        }
+
+        m_Next++;
+        m_NextPosition.Y += FONT_SIZE<float> + FONT_SPACING<float>;
+    }
+
+    // Whether any line was added, removed or rewritten since the last frame
+    // presented
+    [[nodiscard]] constexpr bool HasChanged() const noexcept { return m_Changed; }
+    constexpr void OnPresented() noexcept
+    {
+        for (DebugText& line : *this)
+            line.Changed = false;
+
+        m_Changed = false;
     }
     
-    [[nodiscard]] constexpr size_t Size() const noexcept { return m_Buffer.size(); }
+    [[nodiscard]] constexpr size_t Size() const noexcept { return m_Size; }
+
+    [[nodiscard]] constexpr ConstIter begin() const noexcept { return m_Buffer.cbegin(); }
+    [[nodiscard]] constexpr ConstIter end() const noexcept { return m_Buffer.cbegin() + Offset(); }
 
     [[nodiscard]] constexpr ConstIter cbegin() const noexcept { return m_Buffer.cbegin(); }
-    [[nodiscard]] constexpr ConstIter cend() const noexcept { return m_Buffer.cend(); }
+    [[nodiscard]] constexpr ConstIter cend() const noexcept { return m_Buffer.cbegin() + Offset(); }
 
     [[nodiscard]] constexpr Iter begin() noexcept { return m_Buffer.begin(); }
-    [[nodiscard]] constexpr Iter end() noexcept { return m_Buffer.end(); }
+    [[nodiscard]] constexpr Iter end() noexcept { return m_Buffer.begin() + Offset(); }
 
-    [[nodiscard]] constexpr RevConstIter crbegin() const noexcept { return m_Buffer.crbegin(); }
+    [[nodiscard]] constexpr RevConstIter crbegin() const noexcept { return RevConstIter(cend()); }
     [[nodiscard]] constexpr RevConstIter crend() const noexcept { return m_Buffer.crend(); }
 
-    [[nodiscard]] constexpr RevConstIter rbegin() const noexcept { return m_Buffer.rbegin(); }
+    [[nodiscard]] constexpr RevConstIter rbegin() const noexcept { return RevConstIter(cend()); }
     [[nodiscard]] constexpr RevConstIter rend() const noexcept { return m_Buffer.rend(); }
 
+private:
+    [[nodiscard]] constexpr std::ptrdiff_t Offset() const noexcept { return static_cast<std::ptrdiff_t>(m_Size); }
+
 private:
     std::vector<DebugText> m_Buffer{};
-    sf::Vector2f           m_NextPosition{INIT_POSITION};
+    size_t                 m_Size{}; // Lines in use, the rest are kept for later
+    size_t                 m_Next{};
+    Vec2f                  m_NextPosition{INIT_POSITION};
+    bool                   m_Changed{};
 };
 
 }
-
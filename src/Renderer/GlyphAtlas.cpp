@@ -0,0 +1,36 @@
+#include "GlyphAtlas.hpp"
+
+namespace c8emu {
+
+void LayoutDebugOverlay(const DebugOverlay& overlay, std::vector<AtlasQuad>& quads) noexcept
+{
+    constexpr i32 PADDING = DebugOverlay::PADDING<i32>;
+    constexpr i32 GLYPH_SIZE = DebugOverlay::FONT_SIZE<i32>;
+
+    quads.clear();
+    for (const DebugText& line : overlay)
+    {
+        const i32 x = static_cast<i32>(line.Position.X);
+        const i32 y = static_cast<i32>(line.Position.Y);
+        const i32 width = static_cast<i32>(line.Text.size()) * GLYPH_SIZE;
+
+        quads.push_back({ x - PADDING, y - PADDING, width + 2 * PADDING, GLYPH_SIZE + 2 * PADDING, GlyphAtlas::SOLID_CELL, C8_TEXT_BOX_COLOR });
+    }
+
+    for (const DebugText& line : overlay)
+    {
+        i32 x = static_cast<i32>(line.Position.X);
+        const i32 y = static_cast<i32>(line.Position.Y);
+
+        // Spaces would only add quads that draw nothing
+        for (const char c : line.Text)
+        {
+            if (c != ' ')
+                quads.push_back({ x, y, GLYPH_SIZE, GLYPH_SIZE, GlyphAtlas::GetCell(c), C8_TEXT_COLOR });
+
+            x += GLYPH_SIZE;
+        }
+    }
+}
+
+}
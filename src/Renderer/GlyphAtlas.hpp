@@ -0,0 +1,80 @@
+#pragma once
+
+#include "DebugOverlay.hpp"
+#include "RenderBackend.hpp"
+
+#include "Core/NintendoNESBitmapFont.hpp"
+#include "Core/Types.hpp"
+
+#include <array>
+#include <vector>
+
+namespace c8emu {
+
+// Every glyph of the bitmap font in one image, plus a fully lit cell for
+// solid rectangles, so that overlay text and its boxes can all be drawn from
+// the same texture. Built at compile time, one byte of coverage per texel.
+class GlyphAtlas final
+{
+public:
+    static constexpr u32 CELL_SIZE  = static_cast<u32>(NINTENDO_NES_FONT_GLYPH_SIZE);
+    static constexpr u32 NUM_GLYPHS = static_cast<u32>(NINTENDO_NES_FONT_LAST_CHAR - NINTENDO_NES_FONT_FIRST_CHAR + 1);
+    static constexpr u32 SOLID_CELL = NUM_GLYPHS;
+    static constexpr u32 COLUMNS    = 16;
+    static constexpr u32 ROWS       = (NUM_GLYPHS + 1 + COLUMNS - 1) / COLUMNS;
+    static constexpr u32 WIDTH      = COLUMNS * CELL_SIZE;
+    static constexpr u32 HEIGHT     = ROWS * CELL_SIZE;
+
+public:
+    constexpr GlyphAtlas() noexcept
+    {
+        for (u32 cell{}; cell <= SOLID_CELL; cell++)
+        {
+            for (u32 y{}; y < CELL_SIZE; y++)
+            {
+                const u8 bits = cell == SOLID_CELL ? 0xFF : NINTENDO_NES_FONT_BITMAP[cell][y];
+                for (u32 x{}; x < CELL_SIZE; x++)
+                    m_Texels[(GetCellY(cell) + y) * WIDTH + GetCellX(cell) + x] = (bits & (0x80 >> x)) ? 0xFF : 0x00;
+            }
+        }
+    }
+
+    // Anything outside of the font is drawn as '?'
+    [[nodiscard]] static constexpr u32 GetCell(char c) noexcept
+    {
+        if (c < NINTENDO_NES_FONT_FIRST_CHAR || c > NINTENDO_NES_FONT_LAST_CHAR)
+            c = '?';
+
+        return static_cast<u32>(c - NINTENDO_NES_FONT_FIRST_CHAR);
+    }
+
+    [[nodiscard]] static constexpr u32 GetCellX(u32 cell) noexcept { return (cell % COLUMNS) * CELL_SIZE; }
+    [[nodiscard]] static constexpr u32 GetCellY(u32 cell) noexcept { return (cell / COLUMNS) * CELL_SIZE; }
+
+    [[nodiscard]] constexpr u8 GetTexel(u32 x, u32 y) const noexcept { return m_Texels[y * WIDTH + x]; }
+    [[nodiscard]] constexpr const u8* GetTexels() const noexcept { return m_Texels.data(); }
+
+private:
+    std::array<u8, WIDTH * HEIGHT> m_Texels{};
+};
+
+constexpr GlyphAtlas C8_GLYPH_ATLAS{};
+
+// A rectangle on screen and the atlas cell stretched over it
+struct AtlasQuad final
+{
+public:
+    i32   X{};
+    i32   Y{};
+    i32   Width{};
+    i32   Height{};
+    u32   Cell{};
+    Color Tint{};
+};
+
+// Lays the overlay out as the box behind every line first, then every glyph
+// on top, scaled from the bitmap font to the overlay's font size. `quads` is
+// overwritten.
+void LayoutDebugOverlay(const DebugOverlay& overlay, std::vector<AtlasQuad>& quads) noexcept;
+
+}
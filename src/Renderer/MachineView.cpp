@@ -0,0 +1,104 @@
+#include "MachineView.hpp"
+
+#include "Emulator/Spec.hpp"
+
+namespace c8emu {
+
+void DrawMachine(RenderContext& ctx, const FrameSnapshot& frame) noexcept
+{
+    const CPUData& cpuData = frame.CPU;
+    ctx.DrawBuffer(cpuData.Video.data(), C8_SCREEN_BUFFER_WIDTH<size_t>, C8_SCREEN_BUFFER_HEIGHT<size_t>, cpuData.Dirty);
+
+    if (ctx.DebugOverlayDue())
+    {
+        ctx.AddDebugText("CPU:");
+        ctx.AddDebugText(" ENGINE: {}", GetEngineName(frame.Engine));
+        if (frame.Timing == TimingModel::VIP)
+            ctx.AddDebugText(" TIMING: VIP");
+        else
+            ctx.AddDebugText(" TIMING: {} INSTR/FRAME", frame.InstructionsPerFrame);
+        ctx.AddDebugText(" IPS: {:.0f} ({:.1f}% IDLE)", frame.IPS, frame.IdleShare);
+        ctx.AddDebugText(" SPEED: {:.2f}X{}", frame.Speed, frame.Turbo ? " (TURBO)" : "");
+        ctx.AddDebugText(" REGISTERS:");
+        ctx.AddDebugText("  V0:{} V1:{} V2:{} V3:{}",
+            cpuData.Registers[RegisterID::V0],
+            cpuData.Registers[RegisterID::V1],
+            cpuData.Registers[RegisterID::V2],
+            cpuData.Registers[RegisterID::V3]
+        );
+        ctx.AddDebugText("  V4:{} V5:{} V6:{} V7:{}",
+            cpuData.Registers[RegisterID::V4],
+            cpuData.Registers[RegisterID::V5],
+            cpuData.Registers[RegisterID::V6],
+            cpuData.Registers[RegisterID::V7]
+        );
+        ctx.AddDebugText("  V8:{} V9:{} VA:{} VB:{}",
+            cpuData.Registers[RegisterID::V8],
+            cpuData.Registers[RegisterID::V9],
+            cpuData.Registers[RegisterID::VA],
+            cpuData.Registers[RegisterID::VB]
+        );
+        ctx.AddDebugText("  VC:{} VD:{} VE:{} VF:{}",
+            cpuData.Registers[RegisterID::VC],
+            cpuData.Registers[RegisterID::VD],
+            cpuData.Registers[RegisterID::VE],
+            cpuData.Registers[RegisterID::VF]
+        );
+
+        ctx.AddDebugText(" INDEX REGISTER: {}", cpuData.Idx);
+        ctx.AddDebugText(" PROGRAM COUNTER: {}", cpuData.PC);
+
+        ctx.AddDebugText(" DELAY TIMER: {}", cpuData.DT);
+        ctx.AddDebugText(" SOUND TIMER: {}", cpuData.ST);
+
+        if (frame.Engine == EngineID::TIERED)
+        {
+            const TierStats& stats = frame.Tiers;
+
+            u64 retired{};
+            for (const u64 count : stats.Retired)
+                retired += count;
+
+            ctx.AddDebugText(" TIERS:");
+            for (size_t i{}; i < C8_NUM_TIERS; i++)
+            {
+                const float share = retired > 0 ? 100.0f * static_cast<float>(stats.Retired[i]) / static_cast<float>(retired) : 0.0f;
+                ctx.AddDebugText("  {}: {} ENTRIES, {} PROMOTED, {:.1f}% OF INSTR",
+                    GetTierName(static_cast<Tier>(i)),
+                    stats.Entries[i],
+                    stats.Promotions[i],
+                    share
+                );
+            }
+            ctx.AddDebugText("  DEMOTIONS: {}", stats.Demotions);
+        }
+
+        ctx.AddDebugText(" KEYPAD:{}", frame.WaitingForKey ? " (WAITING)" : "");
+        ctx.AddDebugText("  K1:{} K2:{} K3:{} KC:{}",
+            cpuData.Keypad[0x1],
+            cpuData.Keypad[0x2],
+            cpuData.Keypad[0x3],
+            cpuData.Keypad[0xC]
+        );
+        ctx.AddDebugText("  K4:{} K5:{} K6:{} KD:{}",
+            cpuData.Keypad[0x4],
+            cpuData.Keypad[0x5],
+            cpuData.Keypad[0x6],
+            cpuData.Keypad[0xD]
+        );
+        ctx.AddDebugText("  K7:{} K8:{} K9:{} KE:{}",
+            cpuData.Keypad[0x7],
+            cpuData.Keypad[0x8],
+            cpuData.Keypad[0x9],
+            cpuData.Keypad[0xE]
+        );
+        ctx.AddDebugText("  KA:{} K0:{} KB:{} KF:{}",
+            cpuData.Keypad[0xA],
+            cpuData.Keypad[0x0],
+            cpuData.Keypad[0xB],
+            cpuData.Keypad[0xF]
+        );
+    }
+}
+
+}
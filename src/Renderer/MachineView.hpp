@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Renderer.hpp"
+
+#include "Emulator/Chip8.hpp"
+
+namespace c8emu {
+
+// Draws the display and, with the overlay enabled, the machine state. Shared
+// by every frontend, whatever the backend.
+void DrawMachine(RenderContext& ctx, const FrameSnapshot& frame) noexcept;
+
+}
@@ -0,0 +1,56 @@
+#include "RenderBackend.hpp"
+
+#include "Core/Platform.hpp"
+
+namespace c8emu {
+
+class NullBackend final : public RenderBackend
+{
+public:
+    void Begin() noexcept override {}
+    void DrawBuffer(UNUSED const u64* rows, UNUSED size_t width, UNUSED size_t height, UNUSED u32 dirtyRows) noexcept override {}
+    void End(UNUSED const DebugOverlay& overlay) noexcept override {}
+
+    void OnResize(UNUSED u32 width, UNUSED u32 height) noexcept override {}
+
+    [[nodiscard]] BackendID GetID() const noexcept override { return BackendID::NONE; }
+};
+
+struct BackendInfo final
+{
+public:
+    BackendID        ID{};
+    std::string_view Name{};
+};
+
+static constexpr BackendInfo s_Backends[] = {
+    { BackendID::SFML,     "sfml"     },
+    { BackendID::NONE,     "null"     },
+    { BackendID::CPU,      "cpu"      },
+    { BackendID::CPU_MONO, "cpu-mono" },
+};
+
+std::string_view GetBackendName(BackendID id) noexcept
+{
+    for (const BackendInfo& info : s_Backends)
+        if (info.ID == id)
+            return info.Name;
+
+    return "unknown";
+}
+
+std::optional<BackendID> ParseBackendID(std::string_view name) noexcept
+{
+    for (const BackendInfo& info : s_Backends)
+        if (info.Name == name)
+            return info.ID;
+
+    return std::nullopt;
+}
+
+std::unique_ptr<RenderBackend> CreateNullBackend() noexcept
+{
+    return std::make_unique<NullBackend>();
+}
+
+}
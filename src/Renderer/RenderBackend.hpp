@@ -0,0 +1,86 @@
+#pragma once
+
+#include "DebugOverlay.hpp"
+
+#include "Core/Types.hpp"
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace c8emu {
+
+struct Color final
+{
+public:
+    u8 R{};
+    u8 G{};
+    u8 B{};
+    u8 A{};
+};
+
+static_assert(sizeof(Color) == 4, "Colours are copied straight into RGBA8 pixels");
+
+constexpr Color C8_BG_COLOR       = { 0,   0,   255, 255 };
+constexpr Color C8_FG_COLOR       = { 255, 255, 255, 255 };
+constexpr Color C8_TEXT_COLOR     = { 255, 255, 255, 255 };
+constexpr Color C8_TEXT_BOX_COLOR = { 0,   0,   0,   128 };
+
+// Maps every value a display pixel can hold to its colour. Modes with more
+// than one plane only need a different palette, not another pass.
+using Palette = std::array<Color, 256>;
+
+[[nodiscard]] constexpr Palette MakePalette(Color background, Color foreground) noexcept
+{
+    Palette palette{};
+    palette.fill(foreground);
+    palette[0] = background;
+
+    return palette;
+}
+
+constexpr Palette C8_DEFAULT_PALETTE = MakePalette(C8_BG_COLOR, C8_FG_COLOR);
+
+enum class BackendID : u8
+{
+    SFML,
+    NONE,
+    CPU,
+    CPU_MONO,
+};
+
+// Where the frames end up. The renderer drives a backend through the same
+// sequence for every frame it presents: Begin(), DrawBuffer(), then End()
+// with whatever the debug overlay collected. Frames that would look the same
+// as the last one are not presented at all.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() noexcept = default;
+
+    virtual void Begin() noexcept = 0;
+    // One bit per pixel and one word per row, with the leftmost pixel in the
+    // most significant bit. Pixels are looked up in the palette. Only the
+    // rows set in `dirtyRows` changed since the last frame presented, so
+    // backends that keep the image around need not touch the others.
+    virtual void DrawBuffer(const u64* rows, size_t width, size_t height, u32 dirtyRows) noexcept = 0;
+    virtual void End(const DebugOverlay& overlay) noexcept = 0;
+
+    virtual void OnResize(u32 width, u32 height) noexcept = 0;
+
+    [[nodiscard]] virtual BackendID GetID() const noexcept = 0;
+
+    constexpr void SetPalette(const Palette& palette) noexcept { m_Palette = palette; }
+
+protected:
+    Palette m_Palette{C8_DEFAULT_PALETTE};
+};
+
+[[nodiscard]] std::string_view GetBackendName(BackendID id) noexcept;
+[[nodiscard]] std::optional<BackendID> ParseBackendID(std::string_view name) noexcept;
+
+// Draws nothing at all, for measuring everything up to the backend
+[[nodiscard]] std::unique_ptr<RenderBackend> CreateNullBackend() noexcept;
+
+}
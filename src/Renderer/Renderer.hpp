@@ -1,17 +1,35 @@
 #pragma once
 
 #include "DebugOverlay.hpp"
+#include "RenderBackend.hpp"
 
 #include "Core/Types.hpp"
 
-#include <SFML/Graphics/Font.hpp>
-#include <SFML/Graphics/RenderTexture.hpp>
-#include <SFML/Graphics/RenderWindow.hpp>
-
 #include <format>
+#include <memory>
 
 namespace c8emu {
 
+// Frames the renderer went through, how many of them changed the display
+// and how many were actually presented
+struct RenderStats final
+{
+public:
+    u64 Frames{};
+    u64 Changed{};
+    u64 Presented{};
+};
+
+// The buffer to draw this frame, handed to the backend in Renderer::End()
+struct BufferDraw final
+{
+public:
+    const u64* Rows{};
+    size_t     Width{};
+    size_t     Height{};
+    u32        DirtyRows{};
+};
+
 class RenderContext final
 {
 public:
@@ -19,57 +37,76 @@ public:
     RenderContext(const RenderContext&) = delete;
     RenderContext(RenderContext&&) = delete;
 
-    void DrawBuffer(const Byte* buffer, size_t width, size_t height) const noexcept;
+    // The rows have to stay valid until Renderer::End(). Only the last
+    // buffer of a frame is drawn.
+    constexpr void DrawBuffer(const u64* rows, size_t width, size_t height, u32 dirtyRows) noexcept { m_Draw = { rows, width, height, dirtyRows }; }
 
-    constexpr bool DebugOverlayEnabled() const noexcept { return m_DrawDebugOverlay; }
+    // Whether the overlay is shown and due for new text this frame. Lines
+    // added on other frames are ignored, the overlay keeps the last ones.
+    constexpr bool DebugOverlayDue() const noexcept { return m_RefreshDebugOverlay; }
 
     template<typename ... Args>
     constexpr void AddDebugText(std::format_string<Args...> fmt, Args&& ... args) noexcept
     {
-        if (!m_DrawDebugOverlay)
+        if (!m_RefreshDebugOverlay)
             return;
 
         m_DebugOverlay.Append(fmt, std::forward<Args>(args)...);
     }
 
 private:
-    constexpr RenderContext(sf::RenderTexture& target, DebugOverlay& overlay, bool drawDebugOverlay) noexcept :
-        m_Target(target),
+    constexpr RenderContext(BufferDraw& draw, DebugOverlay& overlay, bool refreshDebugOverlay) noexcept :
+        m_Draw(draw),
         m_DebugOverlay(overlay),
-        m_DrawDebugOverlay(drawDebugOverlay) {};
+        m_RefreshDebugOverlay(refreshDebugOverlay) {};
 
 private:
-    sf::RenderTexture& m_Target;
-    DebugOverlay&      m_DebugOverlay;
-    const bool         m_DrawDebugOverlay{};
+    BufferDraw&   m_Draw;
+    DebugOverlay& m_DebugOverlay;
+    const bool    m_RefreshDebugOverlay{};
 
     friend class Renderer;
 };
 
+// Frames that change nothing on screen are not presented. The debug overlay
+// only counts as a change when the text of one of its lines does, and its
+// text is only refreshed a few times a second.
 class Renderer final
 {
 public:
-    constexpr Renderer() noexcept = default;
+    Renderer() noexcept = default;
 
-    void Init(sf::Vector2u windowSize, sf::Vector2u targetSize) noexcept;
+    void Init(std::unique_ptr<RenderBackend> backend) noexcept;
     void Shutdown() noexcept;
 
-    [[nodiscard]] RenderContext Begin() noexcept;
-    void End(RenderContext&& ctx, sf::RenderWindow& window) noexcept;
+    // `dt` is the time since the last frame, which paces the overlay
+    [[nodiscard]] RenderContext Begin(float dt) noexcept;
+    // Returns whether the frame was presented
+    bool End(RenderContext&& ctx) noexcept;
 
-    void OnResize(sf::Vector2u newSize) noexcept;
+    void OnResize(u32 width, u32 height) noexcept;
+
+    // Presents the next frame in full, e.g. after a palette change
+    constexpr void Invalidate() noexcept { m_Invalidated = true; }
 
     void ToggleDebugOverlay() noexcept;
+    constexpr void SetDebugOverlay(bool enabled) noexcept { m_DrawDebugOverlay = enabled; m_Invalidated = true; }
+    // Refreshes of the overlay text per second, zero for every frame
+    constexpr void SetDebugOverlayRate(float rate) noexcept { m_DebugOverlayInterval = rate > 0.0f ? 1.0f / rate : 0.0f; }
 
-private:
-    void DrawDebugOverlay(sf::RenderWindow& window) noexcept;
+    [[nodiscard]] inline RenderBackend& GetBackend() noexcept { return *m_Backend; }
+    [[nodiscard]] constexpr const RenderStats& GetStats() const noexcept { return m_Stats; }
 
 private:
-    sf::RenderTexture m_Target{};
-    sf::Font          m_Font{};
-    DebugOverlay      m_DebugOverlay{};
-    float             m_Scale{};
-    bool              m_DrawDebugOverlay{};
+    std::unique_ptr<RenderBackend> m_Backend{};
+    DebugOverlay                   m_DebugOverlay{};
+    BufferDraw                     m_Draw{};
+    RenderStats                    m_Stats{};
+    float                          m_DebugOverlayInterval{1.0f / DebugOverlay::DEFAULT_REFRESH_RATE};
+    float                          m_DebugOverlayTick{};
+    bool                           m_DrawDebugOverlay{};
+    bool                           m_RefreshDebugOverlay{};
+    bool                           m_Invalidated{true};
 };
 
 }
@@ -0,0 +1,149 @@
+#include "SFMLBackend.hpp"
+
+#include "Core/Debug.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace c8emu {
+
+[[nodiscard]] static constexpr sf::Color ToSFML(Color color) noexcept
+{
+    return { color.R, color.G, color.B, color.A };
+}
+
+SFMLBackend::SFMLBackend(sf::RenderWindow& window, sf::Vector2u targetSize) noexcept :
+    m_Window(window)
+{
+    // Coverage goes into alpha, so that vertex colours tint the glyphs
+    std::vector<u8> atlas(static_cast<size_t>(GlyphAtlas::WIDTH) * GlyphAtlas::HEIGHT * 4, 0xFF);
+    for (size_t i{}; i < atlas.size() / 4; i++)
+        atlas[i * 4 + 3] = C8_GLYPH_ATLAS.GetTexels()[i];
+
+    if (!m_Atlas.resize({ GlyphAtlas::WIDTH, GlyphAtlas::HEIGHT }))
+        Panic(ErrorCode::FAILED_TO_LOAD_TARGET, "Failed to load glyph atlas");
+
+    m_Atlas.update(atlas.data());
+
+    if (!m_Texture.resize(targetSize))
+        Panic(ErrorCode::FAILED_TO_LOAD_TARGET, "Failed to load render target");
+    
+    m_Pixels.resize(static_cast<size_t>(targetSize.x) * static_cast<size_t>(targetSize.y) * 4);
+    m_Scale = static_cast<float>(window.getSize().x) / static_cast<float>(targetSize.x);
+}
+
+void SFMLBackend::Begin() noexcept
+{
+    m_Window.clear(ToSFML(m_Palette[0]));
+}
+
+void SFMLBackend::DrawBuffer(const u64* rows, size_t width, size_t height, u32 dirtyRows) noexcept
+{
+    constexpr size_t MASK_BITS = sizeof(dirtyRows) * 8;
+
+    // A new texture starts out with nothing in it, and rows past the mask
+    // are never reported
+    const sf::Vector2u size = { static_cast<u32>(width), static_cast<u32>(height) };
+    bool full = height > MASK_BITS;
+    if (m_Texture.getSize() != size)
+    {
+        if (!m_Texture.resize(size))
+            Panic(ErrorCode::FAILED_TO_LOAD_TARGET, "Failed to load render target");
+
+        m_Pixels.resize(width * height * 4);
+        full = true;
+    }
+
+    // Everything from the first changed row to the last goes up in one piece
+    const size_t first = full ? 0 : static_cast<size_t>(std::countr_zero(dirtyRows));
+    const size_t last = full ? height : std::min(height, MASK_BITS - static_cast<size_t>(std::countl_zero(dirtyRows)));
+    if (first < last)
+    {
+        u8* pixel = m_Pixels.data() + first * width * 4;
+        for (size_t y = first; y < last; y++)
+        {
+            for (size_t x{}; x < width; x++, pixel += 4)
+            {
+                const size_t index = (rows[y] >> (63 - x)) & 0x01;
+                std::memcpy(pixel, &m_Palette[index], sizeof(Color));
+            }
+        }
+
+        const u8* begin = m_Pixels.data() + first * width * 4;
+        m_Texture.update(begin, { size.x, static_cast<u32>(last - first) }, { 0, static_cast<u32>(first) });
+    }
+
+    const sf::Vector2f scale = { m_Scale, m_Scale, };
+    const sf::Vector2f position = {
+        0.0f,
+        (static_cast<float>(m_Window.getSize().y) - static_cast<float>(height) * m_Scale) * 0.5f,
+    };
+
+    sf::Sprite sprite(m_Texture);
+    sprite.setPosition(position);
+    sprite.setScale(scale);
+
+    m_Window.draw(sprite);
+}
+
+void SFMLBackend::End(const DebugOverlay& overlay) noexcept
+{
+    DrawDebugOverlay(overlay);
+    m_Window.display();
+}
+
+void SFMLBackend::OnResize(u32 width, UNUSED u32 height) noexcept
+{
+    const float windowWidth = static_cast<float>(width);
+    const float frameBufferWidth = static_cast<float>(m_Texture.getSize().x);
+    
+    m_Scale = windowWidth / frameBufferWidth;
+    C8_LOG_WARNING("Framebuffer scale adjusted: {:.2f}", m_Scale);
+}
+
+void SFMLBackend::DrawDebugOverlay(const DebugOverlay& overlay) noexcept
+{
+    constexpr size_t VERTICES_PER_QUAD = 6;
+
+    if (overlay.HasChanged() || m_Overlay.getVertexCount() == 0)
+    {
+        LayoutDebugOverlay(overlay, m_Quads);
+
+        m_Overlay.resize(m_Quads.size() * VERTICES_PER_QUAD);
+        for (size_t i{}; i < m_Quads.size(); i++)
+        {
+            const AtlasQuad& quad = m_Quads[i];
+            const sf::Color color = ToSFML(quad.Tint);
+
+            const sf::Vector2f min = { static_cast<float>(quad.X), static_cast<float>(quad.Y) };
+            const sf::Vector2f max = min + sf::Vector2f(static_cast<float>(quad.Width), static_cast<float>(quad.Height));
+            const sf::Vector2f uvMin = { static_cast<float>(GlyphAtlas::GetCellX(quad.Cell)), static_cast<float>(GlyphAtlas::GetCellY(quad.Cell)) };
+            const sf::Vector2f uvMax = uvMin + sf::Vector2f(static_cast<float>(GlyphAtlas::CELL_SIZE), static_cast<float>(GlyphAtlas::CELL_SIZE));
+
+            const sf::Vertex corners[VERTICES_PER_QUAD] = {
+                { min,              color, uvMin              },
+                { { max.x, min.y }, color, { uvMax.x, uvMin.y } },
+                { max,              color, uvMax              },
+                { min,              color, uvMin              },
+                { max,              color, uvMax              },
+                { { min.x, max.y }, color, { uvMin.x, uvMax.y } },
+            };
+
+            for (size_t v{}; v < VERTICES_PER_QUAD; v++)
+                m_Overlay[i * VERTICES_PER_QUAD + v] = corners[v];
+        }
+    }
+
+    m_Window.draw(m_Overlay, sf::RenderStates(&m_Atlas));
+}
+
+std::unique_ptr<RenderBackend> CreateSFMLBackend(sf::RenderWindow& window, sf::Vector2u targetSize) noexcept
+{
+    return std::make_unique<SFMLBackend>(window, targetSize);
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "GlyphAtlas.hpp"
+#include "RenderBackend.hpp"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace c8emu {
+
+// The display is expanded through the palette into a texture of its own
+// size and drawn scaled onto the window. Only the rows that changed are
+// expanded and uploaded again. The overlay is drawn from the glyph atlas.
+class SFMLBackend final : public RenderBackend
+{
+public:
+    SFMLBackend(sf::RenderWindow& window, sf::Vector2u targetSize) noexcept;
+
+    void Begin() noexcept override;
+    void DrawBuffer(const u64* rows, size_t width, size_t height, u32 dirtyRows) noexcept override;
+    void End(const DebugOverlay& overlay) noexcept override;
+
+    void OnResize(u32 width, u32 height) noexcept override;
+
+    [[nodiscard]] BackendID GetID() const noexcept override { return BackendID::SFML; }
+
+private:
+    void DrawDebugOverlay(const DebugOverlay& overlay) noexcept;
+
+private:
+    sf::RenderWindow&      m_Window;
+    sf::Texture            m_Texture{};
+    sf::Texture            m_Atlas{};
+    std::vector<u8>        m_Pixels{}; // RGBA8 staging for the texture
+    std::vector<AtlasQuad> m_Quads{};
+    sf::VertexArray        m_Overlay{sf::PrimitiveType::Triangles}; // All of it in one draw, rebuilt only when it changes
+    float                  m_Scale{};
+};
+
+[[nodiscard]] std::unique_ptr<RenderBackend> CreateSFMLBackend(sf::RenderWindow& window, sf::Vector2u targetSize) noexcept;
+
+}